@@ -26,6 +26,7 @@
 #define ViewerInterface_H
 
 #include <QtPlugin>
+#include <QImage>
 #include "documentpage.h"
 #include "applicationwindow.h"
 /**
@@ -38,8 +39,20 @@ public:
     virtual ~ViewerInterface() {}
     virtual DocumentPage *createDocumentPage(ApplicationWindow::DocumentType documentType, const QString &filePath) = 0;
 
+    /*!
+     * \brief Returns a preview of the first page of the document scaled to fit size,
+     * or a null image when there is none. Called from a background thread.
+     */
+    virtual QImage documentThumbnail(const QString &filePath, const QSize &size) = 0;
+
+    /*!
+     * \brief Initialises the document engines before a document is known, so
+     * that opening the first document does not pay for it.
+     */
+    virtual void preload() = 0;
+
 };
 
-Q_DECLARE_INTERFACE(ViewerInterface, "com.office.OfficeTools.ViewerInterface/1.0")
+Q_DECLARE_INTERFACE(ViewerInterface, "com.office.OfficeTools.ViewerInterface/1.2")
 
 #endif
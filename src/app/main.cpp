@@ -35,6 +35,9 @@
 #include "officetoolsserviceifadaptor.h"
 #include "applicationwindow.h"
 #include "applicationservice.h"
+#include "definitions.h"
+#include "tracepoint.h"
+#include "idletimer.h"
 
 static QString parse_filename(int argc, char** argv)
 {
@@ -96,6 +99,8 @@ static void message_handler(QtMsgType type, const char *msg)
 
 M_EXPORT int main(int argc, char** argv)
 {
+    TracePoint::mark("main", "startup");
+
     QString file = "";
     bool showfrontpage = false;
 
@@ -140,6 +145,15 @@ M_EXPORT int main(int argc, char** argv)
         applicationService->setFrontPageLaunched(true);
     }
 
+    if (showfrontpage || file.isEmpty()) {
+        // The viewer is ready well before the user picks the next document.
+        // Loading it blocks, so it waits until the user leaves the list
+        // alone, and a document coming from the booster with launch() is
+        // opened first.
+        IdleTimer::singleShot(ViewerPreloadDelay, window, SLOT(preloadViewer()));
+    }
+
+    TracePoint::mark("exec", "startup");
     int result = app->exec();
 
     delete window;
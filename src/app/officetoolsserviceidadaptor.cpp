@@ -49,3 +49,10 @@ bool OfficeServiceIfAdaptor::launchFile(const QString &filename)
     return out0;
 }
 
+QVariantMap OfficeServiceIfAdaptor::perfCounters()
+{
+    // handle method call com.nokia.maemo.meegotouch.OfficeToolsInterface.perfCounters
+    QVariantMap out0;
+    QMetaObject::invokeMethod(parent(), "perfCounters", Q_RETURN_ARG(QVariantMap, out0));
+    return out0;
+}
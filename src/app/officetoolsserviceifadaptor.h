@@ -76,6 +76,20 @@ class OfficeServiceIfAdaptor: public QDBusAbstractAdaptor
 "      <arg direction=\"in\" type=\"s\" name=\"filename\"/>\n"
 "      <arg direction=\"out\" type=\"b\" name=\"\"/>\n"
 "    </method>\n"
+"    <method name=\"perfCounters\">\n"
+"      <!--doc>\n"
+"                <arg tag=\"brief\">\n"
+"                    Returns the performance counters of the process.\n"
+"                </arg>\n"
+"                <arg tag=\"details\">\n"
+"                    Cache hits, misses, evictions and bytes, render queue\n"
+"                    depth, search throughput and histograms of render,\n"
+"                    paint and search times in microseconds.\n"
+"                </arg>\n"
+"            </doc-->\n"
+"      <arg direction=\"out\" type=\"a{sv}\" name=\"\"/>\n"
+"      <annotation value=\"QVariantMap\" name=\"com.trolltech.QtDBus.QtTypeName.Out0\"/>\n"
+"    </method>\n"
 "    <signal name=\"showFrontPage\"/>\n"
 "    <signal name=\"lookForPopup\"/>\n"
 "    <signal name=\"closeFile\"/>\n"
@@ -89,6 +103,7 @@ public: // PROPERTIES
 public Q_SLOTS: // METHODS
     bool OpenFile(const QString &filename);
     bool launchFile(const QString &filename);
+    QVariantMap perfCounters();
 Q_SIGNALS: // SIGNALS
     void closeFile();
     void lookForPopup();
@@ -23,7 +23,12 @@
 #include <MComboBox>
 #include <MLocale>
 #include <MAction>
+#include <MApplication>
+#include <MApplicationWindow>
 #include <QDebug>
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QSet>
 #include "actionpool.h"
 #include "definitions.h"
 
@@ -39,6 +44,7 @@ public:
 
     QHash<ActionPool::Id, MAction*> actions;
     qreal userDefinedZoomFactor;
+    QSet<const QGraphicsItem *> disabledScopes;
 };
 
 ActionPoolPrivate::ActionPoolPrivate()
@@ -173,6 +179,36 @@ MAction * ActionPool::getAction(ActionPool::Id id) const
     return action;
 }
 
+void ActionPool::connectAction(ActionPool::Id id, QObject *receiver, const char *member, QGraphicsItem *scope)
+{
+    new ActionConnection(getAction(id), receiver, member, scope);
+}
+
+void ActionPool::disconnectAction(ActionPool::Id id, QObject *receiver, const char *member)
+{
+    const MAction *action = getAction(id);
+
+    foreach(ActionConnection *connection, receiver->findChildren<ActionConnection *>()) {
+        if(connection->parent() == receiver && connection->matches(action, member)) {
+            delete connection;
+        }
+    }
+}
+
+void ActionPool::setScopeEnabled(const QGraphicsItem *scope, bool enabled)
+{
+    if(enabled) {
+        data->disabledScopes.remove(scope);
+    } else {
+        data->disabledScopes.insert(scope);
+    }
+}
+
+bool ActionPool::isScopeEnabled(const QGraphicsItem *scope) const
+{
+    return !data->disabledScopes.contains(scope);
+}
+
 void ActionPool::setUserDefinedZoomFactor(qreal factor)
 {
     if(data->userDefinedZoomFactor != factor) {
@@ -195,3 +231,34 @@ void ActionPool::updateUserDefinedZoomFactortext()
 
 #endif
 }
+
+ActionConnection::ActionConnection(MAction *action, QObject *receiver, const char *member, QGraphicsItem *scope)
+    : QObject(receiver)
+    , action(action)
+    , member(member)
+    , scope(scope)
+{
+    connect(action, SIGNAL(triggered()), this, SLOT(actionTriggered()));
+    connect(this, SIGNAL(triggered()), receiver, member);
+}
+
+bool ActionConnection::matches(const MAction *action, const char *member) const
+{
+    return this->action == action && this->member == member;
+}
+
+void ActionConnection::actionTriggered()
+{
+    if(!ActionPool::instance()->isScopeEnabled(scope)) {
+        return;
+    }
+
+    MApplicationWindow *window = MApplication::activeApplicationWindow();
+
+    if(scope->scene() && window && scope->scene() != window->scene()) {
+        // The action belongs to a document in another window
+        return;
+    }
+
+    emit triggered();
+}
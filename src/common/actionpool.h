@@ -27,6 +27,7 @@
 #include <MAction>
 
 class ActionPoolPrivate;
+class QGraphicsItem;
 
 #include <common_export.h>
 
@@ -141,6 +142,32 @@ public:
      */
     MAction * getAction(ActionPool::Id id) const;
 
+    /*!
+     * \brief Connects an action to a slot or signal of receiver.
+     * Several documents can be open in their own windows in one process, all
+     * sharing the pool. The receiver is only triggered while the window
+     * showing scope is the active one, or when scope is not in any window,
+     * and scope has not been disabled with #setScopeEnabled.
+     * \param id is the action
+     * \param receiver gets the call, the connection is removed with it
+     * \param member is the SLOT() or SIGNAL() to call, without arguments
+     * \param scope is the item whose window must be active
+     */
+    void connectAction(ActionPool::Id id, QObject *receiver, const char *member, QGraphicsItem *scope);
+
+    /*!
+     * \brief Removes a connection made with #connectAction
+     */
+    void disconnectAction(ActionPool::Id id, QObject *receiver, const char *member);
+
+    /*!
+     * \brief Stops or resumes triggering the receivers connected with scope,
+     * e.g. while a closed page is kept for opening it again
+     */
+    void setScopeEnabled(const QGraphicsItem *scope, bool enabled);
+
+    bool isScopeEnabled(const QGraphicsItem *scope) const;
+
 public slots:
     /*!
      * \brief Sets the last user defined zoom level.
@@ -169,4 +196,30 @@ private:
 
 };
 
+/*!
+ * \class ActionConnection
+ * \brief Forwards a pool action to one receiver while its window is active.
+ * Created by ActionPool::connectAction.
+ */
+class COMMON_EXPORT ActionConnection: public QObject
+{
+    Q_OBJECT
+
+public:
+    ActionConnection(MAction *action, QObject *receiver, const char *member, QGraphicsItem *scope);
+
+    bool matches(const MAction *action, const char *member) const;
+
+signals:
+    void triggered();
+
+private slots:
+    void actionTriggered();
+
+private:
+    MAction *action;
+    QByteArray member;
+    QGraphicsItem *scope;
+};
+
 #endif //end of ACTIONPOOL_H
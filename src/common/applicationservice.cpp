@@ -113,6 +113,12 @@ void ApplicationService::handleServiceRegistrationFailure()
 
 void ApplicationService::lookForPopup(const QString &file)
 {
+    ApplicationWindow *window = ApplicationWindow::windowForFile(QUrl(file).path());
+    if (window && window != applicationwindow) {
+        window->raiseWindow();
+        return;
+    }
+
     if (!(file.compare(filename))) {
         launch();
     } else {
@@ -127,6 +133,12 @@ void ApplicationService::closeFile(const QString &documentUrn)
 {
     QString file = getFilename(documentUrn);
 
+    ApplicationWindow *window = ApplicationWindow::windowForFile(QUrl(file).path());
+    if (window && window != applicationwindow) {
+        window->exitApplication();
+        return;
+    }
+
     if(!file.isEmpty() &&
        !file.compare(filename) &&
        applicationwindow) {
@@ -146,17 +158,9 @@ void ApplicationService::setFrontPageLaunched(bool launched)
     Q_UNUSED(launched);
 
     if(connection) {
-        // OBS: This is a temporary solution to make sure we are able to listen to the signal from all instances
-        connection->connect("com.nokia.office-tools1", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools2", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools3", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools4", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools5", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools6", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools7", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools8", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools9", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
-        connection->connect("com.nokia.office-tools110", "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
+        // An empty service matches the signal from every instance, whatever
+        // service name it got
+        connection->connect(QString(), "/", Interface, QString("showFrontPage"), this, SLOT(showFrontPage()));
     }
 }
 
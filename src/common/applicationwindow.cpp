@@ -26,7 +26,6 @@
 #include <QDebug>
 #include <QTime>
 #include <QDesktopServices>
-#include <QSettings>
 #include <QPluginLoader>
 
 #include <MLocale>
@@ -40,7 +39,6 @@
 #include <MPannableViewport>
 
 #include <maemo-meegotouch-interfaces/shareuiinterface.h>
-#include <KMimeType>
 #include "applicationwindow.h"
 #include "applicationservice.h"
 #include "allpagespage.h"
@@ -49,11 +47,21 @@
 #include "documentlistmodel.h"
 #include "documentdetailview.h"
 #include "misc.h"
+#include "mimetyperegistry.h"
 #include "ViewerInterface.h"
 #include "trackerutils.h"
+#include "instanceregistry.h"
+#include "documentpagecache.h"
+#include "tracepoint.h"
+#include "perfcounters.h"
+#include "definitions.h"
 
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
+#include <unistd.h>
+
+//! All windows of this process, documents opened later get a window of their own
+static QList<ApplicationWindow *> applicationWindows;
 
 ApplicationWindow::ApplicationWindow(MApplicationWindow *p_appWindow) :
     page(0),
@@ -69,28 +77,22 @@ ApplicationWindow::ApplicationWindow(MApplicationWindow *p_appWindow) :
     frontPageLaunched(false),
     applicationService(0),
     viewerInterface(0),
-    infoBanner(0)
+    infoBanner(0),
+    ownsAppWindow(false),
+    windowClosed(false),
+    displayWait(0),
+    showPending(false)
 {
     setObjectName("applicationwindow");
+    applicationWindows.append(this);
 
     connect(appWindow, SIGNAL(pageChanged(MApplicationPage*)), this, SLOT(slotPageChanged(MApplicationPage*)));
     connect(ActionPool::instance(), SIGNAL(destroyed(QObject *)), this, SLOT(removeActions()));
     connect(appWindow, SIGNAL(displayEntered()), this, SLOT(showPages()));
 
-    QDir path;
-    path.setPath(QDir::homePath() + "/.config/office-tools/");
-
-    if(!path.exists()) {
-        if(!path.mkpath(QDir::homePath() + "/.config/office-tools/")) {
-            qWarning() << "Some serious error in creating the required path" << QDir::homePath() + "/.config/office-tools";
-            return;
-        }
-    }
-
     Qt::WindowStates state = appWindow->windowState();
     appWindow->setWindowState( state | Qt::WindowFullScreen );
 
-    officeToolsSettings = new QSettings(path.filePath("office-tools.cfg"),QSettings::NativeFormat);
     appWindow->setCloseOnLazyShutdown(true);
 }
 
@@ -98,22 +100,22 @@ ApplicationWindow::~ApplicationWindow()
 {
     qDebug() << __PRETTY_FUNCTION__;
 
-    officeToolsSettings->sync();
+    applicationWindows.removeAll(this);
+
+    InstanceRegistry &registry = InstanceRegistry::instance();
 
     if(!filePath.isEmpty()) {
-        officeToolsSettings->setValue(filePath, false);
+        registry.remove(InstanceRegistry::Document, filePath);
     }
 
     if(firstInstance) {
-        officeToolsSettings->setValue("FirstInstanceRunning", false);
+        registry.remove(InstanceRegistry::FirstInstance);
     }
 
     if(frontPageLaunched) {
-        officeToolsSettings->setValue("FrontPageLaunched", false);
+        registry.remove(InstanceRegistry::FrontPage);
     }
 
-    delete officeToolsSettings;
-
     if (infoBanner) {
         delete infoBanner;
     }
@@ -123,7 +125,8 @@ ApplicationWindow::~ApplicationWindow()
 
     QThreadPool *threadPool = QThreadPool::globalInstance();
 
-    if(threadPool->activeThreadCount() > 1) {
+    // The pool is shared with the other windows of this process
+    if(applicationWindows.isEmpty() && threadPool->activeThreadCount() > 1) {
         threadPool->waitForDone();
     }
 
@@ -137,15 +140,23 @@ ApplicationWindow::~ApplicationWindow()
         allPagesPage = 0;
     }
 
-    if(page) {
+    if(applicationWindows.isEmpty()) {
         delete page;
         page = 0;
+        DocumentPageCache::instance().clear();
+    } else {
+        // Another window may open the document again
+        releasePage();
     }
 
     if(docDetail) {
         delete docDetail;
         docDetail = 0;
     }
+
+    if(ownsAppWindow) {
+        delete appWindow;
+    }
 }
 
 void ApplicationWindow::slotPageChanged(MApplicationPage *page)
@@ -162,22 +173,17 @@ void ApplicationWindow::slotPageChanged(MApplicationPage *page)
 
 void ApplicationWindow::OpenListPage()
 {
-    officeToolsSettings->sync();
-    if (officeToolsSettings->value("FrontPageLaunched", false).toBool()) {
-        pid_t pid = officeToolsSettings->value("FrontPageLaunched/PID", 0).toInt();
-        QDir path;
-        path.setPath(QString("/proc/%1").arg(pid));
-
-        if(path.exists()) {
-           QDBusMessage msg = QDBusMessage::createSignal(Path, Interface, QString("showFrontPage"));
-           applicationService->sendMessage(msg);
-           QTimer::singleShot(300, QCoreApplication::instance(), SLOT(quit()));
-           return;
-        }
+    const pid_t frontPagePid = InstanceRegistry::instance().find(InstanceRegistry::FrontPage);
+    if (frontPagePid != 0 && frontPagePid != getpid()) {
+        QDBusMessage msg = QDBusMessage::createSignal(Path, Interface, QString("showFrontPage"));
+        applicationService->sendMessage(msg);
+        QTimer::singleShot(300, this, SLOT(closeWindow()));
+        return;
     }
 
 //    appWindow->setWindowState( appWindow->windowState() & ~Qt::WindowFullScreen );
     if (0 == pageList) {
+        windowClosed = false;
         pageList = new DocumentListPage();
         appWindow->show();
         pageList->appear(appWindow);
@@ -190,9 +196,7 @@ void ApplicationWindow::OpenListPage()
         applicationService->setFrontPageLaunched(true);
 
         frontPageLaunched = true;
-        officeToolsSettings->sync();
-        officeToolsSettings->setValue("FrontPageLaunched", true);
-        officeToolsSettings->setValue("FrontPageLaunched/PID", getpid());
+        InstanceRegistry::instance().add(InstanceRegistry::FrontPage);
     } else {
         pageList->pannableViewport()->setPosition(QPoint(0,0));
     }
@@ -206,16 +210,6 @@ void ApplicationWindow::setApplicationService(ApplicationService *service)
 bool ApplicationWindow::launchFile(const QString& fileName)
 {
     QUrl url(QUrl::fromPercentEncoding(fileName.toUtf8()));
-    if ((TrackerUtils::Instance().urnFromUrl(QUrl::fromLocalFile(url.path()))).isEmpty()) {
-        Atom atomWindowType = XInternAtom(QX11Info::display(),
-                                          "_MEEGOTOUCH_NET_WM_WINDOW_TYPE_SHEET",
-                                          False);
-        XChangeProperty(QX11Info::display(), appWindow->effectiveWinId(),
-                        XInternAtom(QX11Info::display(), "_NET_WM_WINDOW_TYPE",
-                        False),
-                        XA_ATOM, 32, PropModeAppend, (unsigned char*)
-                        &atomWindowType, 1);
-    }
 
     //When launched from application grid, we get -showfrontpage as command line
     //and we show front page i.e. pageList !=0
@@ -226,90 +220,128 @@ bool ApplicationWindow::launchFile(const QString& fileName)
     if(0 == pageList && 0 == page) {
         return OpenFile(fileName);
     }
-    bool alreadyOpened = false;
-    officeToolsSettings->sync();
 
-    if(officeToolsSettings->value(url.path(), false).toBool()) {
-        pid_t pid = officeToolsSettings->value(url.path() + "/PID", 0).toInt();
-        QDir path;
-        path.setPath(QString("/proc/%1").arg(pid));
-        if(path.exists()) {
-            alreadyOpened = true;
-        }
+    const bool showFrontPage = (fileName == "" || fileName == "-showfrontpage");
+    ApplicationWindow *window = showFrontPage ? frontPageWindow() : windowForFile(url.path());
+    if(window) {
+        window->raiseWindow();
+        return true;
     }
 
+    InstanceRegistry &registry = InstanceRegistry::instance();
+    const bool alreadyOpened = !showFrontPage &&
+                               registry.find(InstanceRegistry::Document, url.path()) != 0;
+
     Q_ASSERT(applicationService);
     if(alreadyOpened) {
         QDBusMessage msg = QDBusMessage::createSignal(Path, Interface, QString("lookForPopup"));
         msg << fileName;
         applicationService->sendMessage(msg);
     } else {
-        QStringList args;
-        args << "--type=m";
-        args << "office-tools";
-        if (fileName != "" &&
-            fileName != "-showfrontpage") {
-            args << fileName;
-        } else {
-            args << "-showfrontpage";
-
-            if (officeToolsSettings->value("FrontPageLaunched", false).toBool()) {
-                pid_t pid = officeToolsSettings->value("FrontPageLaunched/PID", 0).toInt();
-                QDir path;
-                path.setPath(QString("/proc/%1").arg(pid));
-
-                if(path.exists()) {
-                   QDBusMessage msg = QDBusMessage::createSignal(Path, Interface, QString("showFrontPage"));
-                   applicationService->sendMessage(msg);
-                   return true;
-                }
-            }
+        if (showFrontPage && registry.find(InstanceRegistry::FrontPage) != 0) {
+            QDBusMessage msg = QDBusMessage::createSignal(Path, Interface, QString("showFrontPage"));
+            applicationService->sendMessage(msg);
+            return true;
         }
 
-        QProcess::startDetached("invoker", args);
+        openWindow(showFrontPage ? QString() : fileName);
     }
 
     return true;
 }
 
-void ApplicationWindow::setIsFirstInstance(bool isFirstInstance)
+void ApplicationWindow::openWindow(const QString &fileName)
 {
-    firstInstance = isFirstInstance;
+    // The new window shares the loaded viewer plugin, the thread pool and
+    // the caches of this process, which a new process would set up again
+    MApplicationWindow *documentWindow = new MApplicationWindow;
+    documentWindow->setWindowTitle(qtTrId("qtn_comm_appname_offi"));
 
-    if(firstInstance) {
-        officeToolsSettings->sync();
-        officeToolsSettings->setValue("FirstInstanceRunning", true);
-        officeToolsSettings->setValue("FirstInstanceRunning/PID", getpid());
+    ApplicationWindow *window = new ApplicationWindow(documentWindow);
+    window->ownsAppWindow = true;
+    window->setApplicationService(applicationService);
+
+    if (fileName.isEmpty()) {
+        window->OpenListPage();
+    } else {
+        window->OpenFile(fileName);
     }
 }
 
-bool ApplicationWindow::firstInstanceRunning()
+ApplicationWindow *ApplicationWindow::windowForFile(const QString &path)
 {
-    if(officeToolsSettings->value("FirstInstanceRunning", false).toBool()) {
-        pid_t pid = officeToolsSettings->value("FirstInstanceRunning/PID", 0).toInt();
-        QDir path;
-        path.setPath(QString("/proc/%1").arg(pid));
+    foreach (ApplicationWindow *window, applicationWindows) {
+        if (window->page && window->hasContent() && window->filePath == path) {
+            return window;
+        }
+    }
+    return 0;
+}
 
-        if(path.exists()) {
-            return true;
+ApplicationWindow *ApplicationWindow::frontPageWindow()
+{
+    foreach (ApplicationWindow *window, applicationWindows) {
+        if (window->pageList && window->hasContent()) {
+            return window;
         }
     }
+    return 0;
+}
 
-    return false;
+bool ApplicationWindow::hasContent() const
+{
+    return !windowClosed && (page || pageList);
 }
 
-bool ApplicationWindow::OpenFile(const QString& fileName)
+void ApplicationWindow::raiseWindow()
 {
-    //If we have old page, remove it and disconnect the signals
-    if(page) {
-        delete page;
-        page = 0;
+    appWindow->show();
+    appWindow->activateWindow();
+    appWindow->raise();
+}
+
+void ApplicationWindow::closeWindow()
+{
+    appWindow->hide();
+    windowClosed = true;
+
+    foreach (ApplicationWindow *window, applicationWindows) {
+        if (window != this && window->hasContent()) {
+            // Other documents stay open, only this window goes. The page may
+            // be the sender, so it is not deleted right here.
+            if (ownsAppWindow) {
+                deleteLater();
+            } else {
+                QTimer::singleShot(0, this, SLOT(closeDocumentPage()));
+            }
+            return;
+        }
     }
 
-    if(allPagesPage) {
-        delete allPagesPage;
-        allPagesPage = 0;
+    QCoreApplication::flush();
+    QCoreApplication::quit();
+}
+
+void ApplicationWindow::setIsFirstInstance(bool isFirstInstance)
+{
+    firstInstance = isFirstInstance;
+
+    if(firstInstance) {
+        InstanceRegistry::instance().add(InstanceRegistry::FirstInstance);
     }
+}
+
+bool ApplicationWindow::firstInstanceRunning()
+{
+    return InstanceRegistry::instance().find(InstanceRegistry::FirstInstance) != 0;
+}
+
+bool ApplicationWindow::OpenFile(const QString& fileName)
+{
+    TracePoint trace("OpenFile", "startup");
+
+    //If we have old page, remove it and disconnect the signals
+    releasePage();
 
     if(docDetail) {
         delete docDetail;
@@ -317,65 +349,47 @@ bool ApplicationWindow::OpenFile(const QString& fileName)
     }
 
     QUrl url(QUrl::fromPercentEncoding(fileName.toUtf8()));
+    if(!filePath.isEmpty() && filePath != url.path()) {
+        InstanceRegistry::instance().remove(InstanceRegistry::Document, filePath);
+    }
     filePath = url.path();
+    windowClosed = false;
 
-    if ((TrackerUtils::Instance().urnFromUrl(QUrl::fromLocalFile(url.path()))).isEmpty()) {
-        Atom atomWindowType = XInternAtom(QX11Info::display(),
-                                          "_MEEGOTOUCH_NET_WM_WINDOW_TYPE_SHEET",
-                                          False);
-        XChangeProperty(QX11Info::display(), appWindow->effectiveWinId(),
-                        XInternAtom(QX11Info::display(), "_NET_WM_WINDOW_TYPE",
-                        False),
-                        XA_ATOM, 32, PropModeAppend, (unsigned char*)
-                        &atomWindowType, 1);
-    }
+    requestWindowType(url.path());
 
 //    appWindow->setWindowState( appWindow->windowState() | Qt::WindowFullScreen );
-    officeToolsSettings->sync();
-    officeToolsSettings->setValue(filePath, true);
-    officeToolsSettings->setValue(filePath + "/PID", getpid());
+    InstanceRegistry::instance().add(InstanceRegistry::Document, filePath);
 
-    QFileInfo fileInfo(filePath);
-    DocumentType fileType = checkMimeType(fileInfo.filePath());
+    // Detected once here, the page and the viewer get it from the page
+    const QString mimeType = MimeTypeRegistry::mimeTypeForPath(filePath);
+    DocumentType fileType = static_cast<DocumentType>(MimeTypeRegistry::viewerType(mimeType));
 
-    QString error("Unknown Error");
-    if (!viewerInterface) {
-        //load plugin
-        const QDir pluginDir("/usr/lib/office-tools/viewer");
-        const QStringList plugins = pluginDir.entryList(QDir::Files);
-        if (plugins.size() == 0) {
-            error = "No plugins oufnd in /usr/lib/office-tools";
+    page = DocumentPageCache::instance().take(filePath);
+    displayWait = 10;
+
+    if(!page) {
+        QString error;
+        if (!viewerInterface) {
+            viewerInterface = viewerPlugin(error);
         }
-        for (int i = 0; i < plugins.size(); ++i) {
-            QPluginLoader *loader = new QPluginLoader(pluginDir.absoluteFilePath(plugins.at(i)));
-	    qDebug() << "pluginloader" << loader;
-	    loader->load();
-            QObject *plugin = loader->instance();
-            if (plugin != 0) {
-                viewerInterface = qobject_cast<ViewerInterface*>(plugin);
-                if (viewerInterface) {
-                    plugin->setParent(this);
-                }
-                else {
-                    delete plugin;
-                }
-                break;
-            }
-            error = loader->errorString();
-	    delete loader;
+        if (!viewerInterface) {
+            error = "Fatal: could not loading viewer plugin " + error;
+            qFatal(error.toAscii());
+            return false;
         }
-
-    }
-    if (!viewerInterface) {
-        error = "Fatal: could not loading viewer plugin " + error;
-        qFatal(error.toAscii());
-        return false;
+        page = viewerInterface->createDocumentPage(fileType, filePath);
     }
-    page = viewerInterface->createDocumentPage(fileType, filePath);
 
     if(page) {
-        appWindow->show();
-        GetSceneManager()->appearSceneWindow(page);
+        page->setMimeType(mimeType);
+        // the window type has to be set before the window is mapped
+        showPending = true;
+        if (windowTypeUrl.isEmpty()) {
+            showWindow();
+        } else {
+            QTimer::singleShot(WindowTypeTimeout, this, SLOT(showWindow()));
+        }
+        appWindow->sceneManager()->appearSceneWindow(page);
         //connect(page,SIGNAL(displayEntered()),this,SLOT(documentPageDisplayEntered()));
         //Using the timer approch as neither displayEntered not appeared signal is getting
         //triggered on the page.
@@ -388,21 +402,80 @@ bool ApplicationWindow::OpenFile(const QString& fileName)
     return true;
 }
 
+void ApplicationWindow::preloadViewer()
+{
+    QString error;
+    if (!viewerInterface) {
+        viewerInterface = viewerPlugin(error);
+    }
+    if (viewerInterface) {
+        viewerInterface->preload();
+    } else {
+        qWarning() << __PRETTY_FUNCTION__ << error;
+    }
+}
+
+QVariantMap ApplicationWindow::perfCounters() const
+{
+    return PerfCounters::values();
+}
+
+ViewerInterface *ApplicationWindow::viewerPlugin(QString &error)
+{
+    static ViewerInterface *viewer = 0;
+    if (viewer) {
+        return viewer;
+    }
+
+    error = "Unknown Error";
+    const QDir pluginDir("/usr/lib/office-tools/viewer");
+    const QStringList plugins = pluginDir.entryList(QDir::Files);
+    if (plugins.size() == 0) {
+        error = "No plugins oufnd in /usr/lib/office-tools";
+    }
+    for (int i = 0; i < plugins.size(); ++i) {
+        QPluginLoader *loader = new QPluginLoader(pluginDir.absoluteFilePath(plugins.at(i)));
+        qDebug() << "pluginloader" << loader;
+        loader->load();
+        QObject *plugin = loader->instance();
+        if (plugin != 0) {
+            // The plugin is shared by the document pages and the front page
+            // thumbnails, so it stays with the application
+            viewer = qobject_cast<ViewerInterface*>(plugin);
+            if (viewer) {
+                plugin->setParent(qApp);
+            }
+            else {
+                delete plugin;
+            }
+            break;
+        }
+        error = loader->errorString();
+        delete loader;
+    }
+    return viewer;
+}
+
 void ApplicationWindow::documentPageDisplayEntered()
 {
-    static int leftOverWait = 10; //This should allow events to process
-    if(leftOverWait == 0)
+    //The wait should allow events to process
+    if(displayWait == 0 || !page)
         return;
     if(page->sceneWindowState() != MSceneWindow::Appeared)
     {
-        --leftOverWait;
+        TracePoint::mark("displayWait", "startup", "left", displayWait);
+        --displayWait;
         QTimer::singleShot(10,this,SLOT(documentPageDisplayEntered()));
         return;
     }
-    leftOverWait = 0;
+    displayWait = 0;
+    TracePoint trace("documentPageDisplayEntered", "startup");
     
     //disconnect(page,SIGNAL(appeared()),this,SLOT(documentPageDisplayEntered()));
-    page->createFinalContent();
+    const bool reopened = page->isDocumentLoaded();
+    if(!reopened) {
+        page->createFinalContent();
+    }
     appWindow->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
     connect(page,SIGNAL(loadFailed(const QString &, const QString &)),
             this,SLOT(loadFailed(const QString &, const QString &)));
@@ -418,7 +491,29 @@ void ApplicationWindow::documentPageDisplayEntered()
     connect(page, SIGNAL(showNormalView()), this, SLOT(showNormalView()));
     connect(page, SIGNAL(saveDocumentAs()), this, SLOT(slotSaveAs()));
     connect(page, SIGNAL(documentCloseEvent()), this, SLOT(exitApplication()));
-    QTimer::singleShot(0, this, SLOT(slotOpenDocument()));
+
+    if(reopened) {
+        // The page comes from the cache with its document already loaded
+        loadSuccess(filePath);
+    } else {
+        QTimer::singleShot(0, this, SLOT(slotOpenDocument()));
+    }
+}
+
+void ApplicationWindow::releasePage()
+{
+    // The all pages view shows thumbnails of the page
+    if(allPagesPage) {
+        delete allPagesPage;
+        allPagesPage = 0;
+    }
+
+    if(page) {
+        disconnect(page, 0, this, 0);
+        page->saveReadingPosition();
+        DocumentPageCache::instance().insert(page);
+        page = 0;
+    }
 }
 
 
@@ -432,64 +527,53 @@ void ApplicationWindow::slotOpenDocument()
 void ApplicationWindow::exitApplication()
 {
     page->disappear();
-    appWindow->hide();
-    QCoreApplication::flush();
-    QCoreApplication::quit();
+    closeWindow();
+}
+
+void ApplicationWindow::requestWindowType(const QString &path)
+{
+    TrackerUtils &tracker = TrackerUtils::Instance();
+    connect(&tracker, SIGNAL(urnFromUrlReady(QUrl, QString)),
+            this, SLOT(windowTypeUrnResolved(QUrl, QString)), Qt::UniqueConnection);
+
+    windowTypeUrl = QUrl::fromLocalFile(path);
+    tracker.requestUrnFromUrl(windowTypeUrl);
+}
+
+void ApplicationWindow::windowTypeUrnResolved(const QUrl &url, const QString &urn)
+{
+    if (url != windowTypeUrl) {
+        return;
+    }
+    windowTypeUrl = QUrl();
+
+    // Files not indexed by tracker are opened in the quick viewer, which is shown as a sheet
+    if (urn.isEmpty()) {
+        Atom atomWindowType = XInternAtom(QX11Info::display(),
+                                          "_MEEGOTOUCH_NET_WM_WINDOW_TYPE_SHEET",
+                                          False);
+        XChangeProperty(QX11Info::display(), appWindow->effectiveWinId(),
+                        XInternAtom(QX11Info::display(), "_NET_WM_WINDOW_TYPE",
+                        False),
+                        XA_ATOM, 32, PropModeAppend, (unsigned char*)
+                        &atomWindowType, 1);
+    }
+
+    showWindow();
+}
+
+void ApplicationWindow::showWindow()
+{
+    if (!showPending) {
+        return;
+    }
+    showPending = false;
+    appWindow->show();
 }
 
 ApplicationWindow::DocumentType ApplicationWindow::checkMimeType(const QString &fileName)
 {
-    ApplicationWindow::DocumentType type = ApplicationWindow::DOCUMENT_UNKOWN;
-    QString mimetype = KMimeType::findByPath(fileName)->name();
-
-    if((QString::compare("application/msword", mimetype) == 0) ||
-       (QString::compare("application/x-mswrite", mimetype) == 0) ||
-       (QString::compare("text/plain", mimetype) == 0) ||
-       (QString::compare("application/vnd.oasis.opendocument.text", mimetype) == 0) ||
-       (QString::compare("application/vnd.openxmlformats-officedocument.wordprocessingml.document", mimetype) == 0) ||
-       (QString::compare("application/rtf", mimetype) == 0) ||
-       (QString::compare("application/x-vnd.oasis.opendocument.text", mimetype) == 0) ||
-       (QString::compare("application/vnd.ms-word.document.macroEnabled.12", mimetype) == 0) ||
-       (QString::compare("application/vnd.openxmlformats-officedocument.wordprocessingml.template", mimetype) == 0) ||
-       (QString::compare("application/vnd.ms-word.template.macroEnabled.12", mimetype) == 0) ||
-       (QString::compare("application/vnd.oasis.opendocument.text-template", mimetype) == 0) ||
-       (QString::compare("application/x-vnd.oasis.opendocument.text-template", mimetype) == 0)) {
-        type = ApplicationWindow::DOCUMENT_WORD;
-    } else if(QString::compare("application/pdf", mimetype) == 0) {
-        type = ApplicationWindow::DOCUMENT_PDF;
-    } else if((QString::compare("application/mspowerpoint", mimetype) == 0) ||
-              (QString::compare("application/vnd.ms-powerpoint", mimetype) == 0) ||
-              (QString::compare("application/vnd.ms-powerpoint.slideshow.macroEnabled.12", mimetype) == 0) ||
-              (QString::compare("application/vnd.oasis.opendocument.presentation", mimetype) == 0) ||
-              (QString::compare("application/vnd.oasis.opendocument.presentation-template", mimetype) == 0) ||
-              (QString::compare("application/x-vnd.oasis.opendocument.presentation-template", mimetype) == 0) ||
-              (QString::compare("application/vnd.openxmlformats-officedocument.presentationml.presentation", mimetype) == 0) ||
-              (QString::compare("application/vnd.openxmlformats-officedocument.presentationml.slideshow", mimetype) == 0) ||
-              (QString::compare("application/vnd.oasis.opendocument.presentation", mimetype) == 0) ||
-              (QString::compare("application/x-vnd.oasis.opendocument.presentation", mimetype) == 0) ||
-              (QString::compare("application/vnd.ms-powerpoint.presentation.macroEnabled.12", mimetype) == 0) ||
-              (QString::compare("application/vnd.ms-powerpoint.addin.macroEnabled.12", mimetype) == 0) ||
-              (QString::compare("application/vnd.openxmlformats-officedocument.presentationml.template", mimetype) == 0)) {
-        type = ApplicationWindow::DOCUMENT_PRESENTATION;
-    } else if((QString::compare("application/vnd.ms-excel", mimetype) == 0) ||
-              (QString::compare("application/vnd.oasis.opendocument.spreadsheet", mimetype) == 0) ||
-              (QString::compare("application/vnd.openxmlformats-officedocument.spreadsheetml.sheet", mimetype) == 0) ||
-              (QString::compare("application/x-vnd.oasis.opendocument.spreadsheet", mimetype) == 0) ||
-              (QString::compare("application/excel", mimetype) == 0) ||
-              (QString::compare("application/vnd.ms-excel.sheet.macroEnabled.12", mimetype) == 0) ||
-              (QString::compare("application/vnd.ms-excel.sheet.binary.macroEnabled.12", mimetype) == 0) ||
-              (QString::compare("application/vnd.oasis.opendocument.spreadsheet-template", mimetype) == 0) ||
-              (QString::compare("application/x-vnd.oasis.opendocument.spreadsheet-template", mimetype) == 0) ||
-              (QString::compare("application/vnd.openxmlformats-officedocument.spreadsheetml.template", mimetype) == 0) ||
-              (QString::compare("application/vnd.ms-excel.template.macroEnabled.12", mimetype) == 0) ||
-              (QString::compare("application/x-excel", mimetype) == 0) ||
-              (QString::compare("application/xlt", mimetype) == 0) ||
-              (QString::compare("application/x-msexcel", mimetype) == 0) ||
-              (QString::compare("application/msexcel", mimetype) == 0)) {
-        type = ApplicationWindow::DOCUMENT_SPREADSHEET;
-    }
-
-    return type;
+    return static_cast<DocumentType>(MimeTypeRegistry::viewerType(MimeTypeRegistry::mimeTypeForPath(fileName)));
 }
 
 
@@ -503,7 +587,7 @@ void ApplicationWindow::loadFailed(const QString &file, const QString &reason)
         showBannerInformation(reason);
     }
     closeDocumentPage();
-    QTimer::singleShot(3000, QCoreApplication::instance(), SLOT(quit()));
+    QTimer::singleShot(3000, this, SLOT(closeWindow()));
 }
 
 void ApplicationWindow::loadSuccess(const QString &file)
@@ -520,11 +604,7 @@ void ApplicationWindow::loadSuccess(const QString &file)
 
 void ApplicationWindow::closeDocumentPage()
 {
-    if(page) {
-        page->disappear();
-        delete page;
-        page = 0;
-    }
+    releasePage();
 
     if(pageList) {
         pageList->disappear();
@@ -610,26 +690,25 @@ void ApplicationWindow::showNormalView()
 
 void ApplicationWindow::showFrontPageView()
 {
-    if(firstInstanceRunning() &&
-       officeToolsSettings->value("FrontPageLaunched", false).toBool()) {
-        pid_t pid = officeToolsSettings->value("FrontPageLaunched/PID", 0).toInt();
-        QDir path;
-        path.setPath(QString("/proc/%1").arg(pid));
+    ApplicationWindow *window = frontPageWindow();
+    if(window && window != this) {
+        window->raiseWindow();
+        closeWindow();
+        return;
+    }
 
-        if(path.exists()) {
-            QDBusMessage msg = QDBusMessage::createSignal(Path, Interface, QString("showFrontPage"));
-            applicationService->sendMessage(msg);
-            appWindow->hide();
-            QCoreApplication::flush();
-            QCoreApplication::quit();
-            return;
-        }
+    const pid_t frontPagePid = InstanceRegistry::instance().find(InstanceRegistry::FrontPage);
+    if(frontPagePid != 0 && frontPagePid != getpid() && firstInstanceRunning()) {
+        QDBusMessage msg = QDBusMessage::createSignal(Path, Interface, QString("showFrontPage"));
+        applicationService->sendMessage(msg);
+        closeWindow();
+        return;
     }
 
     closeDocumentPage();
 
     if(!filePath.isEmpty()) {
-        officeToolsSettings->setValue(filePath, false);
+        InstanceRegistry::instance().remove(InstanceRegistry::Document, filePath);
     }
 
     // Setting to the default service name for front page, it is possible
@@ -779,25 +858,30 @@ void ApplicationWindow::slotDelete()
 
 void ApplicationWindow::deleteConfirmationYes()
 {
+    QStringList deletedPaths;
+
     foreach(QString path,pathsToDelete) {
         qDebug() << "Deleting file " << path;
 
         if(path.isEmpty())
             continue;
 
-        QString documentUrn = TrackerUtils::Instance().urnFromUrl(QUrl(path));
-
         if(QFile::remove(QUrl(QUrl::fromPercentEncoding(path.toUtf8())).path())) {
-            //Successfully deleted...
+            deletedPaths << path;
         }
     }
 
+    // One tracker update for all removed files, so the live query drops them
+    // without waiting for the miner to notice the deletion
+    TrackerUtils::Instance().deleteUrls(deletedPaths);
+
     if(0 != pageList) {
         pageList->docsDeleted(pathsToDelete);
         pageList->closeSubview();
         pageList->refreshList();
     } else if(0 != page) {
-        QCoreApplication::quit();
+        // Documents open in other windows stay open
+        closeWindow();
     }
     pathsToDelete.clear();
 }
@@ -871,16 +955,14 @@ void ApplicationWindow::documentSaved(const QString &fileName)
         newPath = QDir::homePath();
     }
 
-    officeToolsSettings->sync();
+    InstanceRegistry &registry = InstanceRegistry::instance();
     if(!filePath.isEmpty()) {
-        officeToolsSettings->setValue(filePath, false);
+        registry.remove(InstanceRegistry::Document, filePath);
     }
     QUrl url(QUrl::fromPercentEncoding((newPath + "/" + fileName).toUtf8()));
     filePath = url.path();
     applicationService->setFileName(filePath);
-    officeToolsSettings->sync();
-    officeToolsSettings->setValue(filePath, true);
-    officeToolsSettings->setValue(filePath + "/PID", getpid());
+    registry.add(InstanceRegistry::Document, filePath);
 
     page->setDocumentName(newPath + "/" + fileName);
     page->fakeDocumentSaved();
@@ -890,12 +972,7 @@ void ApplicationWindow::documentSaved(const QString &fileName)
 void ApplicationWindow::toNormalView()
 {
     if (page) {
-        QString documentUrn = TrackerUtils::Instance().urnFromUrl(QUrl::fromLocalFile(page->documentName));
-        if (documentUrn.isEmpty()) {
-            QTimer::singleShot(2000, this, SLOT(toNormalView()));
-            return;
-        }
-        page->createFinalContent();
+        page->waitForTrackerIndexing();
     }
 }
 
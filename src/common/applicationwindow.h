@@ -26,6 +26,8 @@
 
 #include <MApplicationWindow>
 #include <MSceneManager>
+#include <QUrl>
+#include <QVariantMap>
 
 #include "documentpage.h"
 
@@ -34,7 +36,6 @@ class AllPagesPage;
 class DocumentListPage;
 class ShareUiInterface;
 class DocumentDetailView;
-class QSettings;
 class ViewerInterface;
 class MBanner;
 #include <common_export.h>
@@ -147,6 +148,17 @@ public slots:
 
     void exitApplication();
 
+    /*!
+     * \brief Loads the viewer plugin and lets it initialise the document
+     * engines ahead of the first document
+     */
+    void preloadViewer();
+
+    /*!
+     * \brief The performance counters of this process, see #PerfCounters
+     */
+    QVariantMap perfCounters() const;
+
 public:
     /*!
      * \brief Static method for checking file family based on the mime type.
@@ -180,6 +192,14 @@ public:
      */
     static MSceneManager* GetSceneManager();
 
+    /*!
+     * \brief Loads the document viewer plugin on first use.
+     *
+     * \param error set to the reason when the plugin can not be loaded
+     * \return The viewer plugin shared by the whole application, 0 on failure
+     */
+    static ViewerInterface *viewerPlugin(QString &error);
+
     /*!
      * \brief sets whether the instance is first instance of office-tools.
      *
@@ -194,6 +214,19 @@ public:
      */
     bool firstInstanceRunning();
 
+    /*!
+     * \brief Finds the window of this process showing a document.
+     *
+     * \param path is the local path of the document
+     * \return The window or 0 if the document is not open in this process
+     */
+    static ApplicationWindow *windowForFile(const QString &path);
+
+    /*!
+     * \brief Brings the window to the front.
+     */
+    void raiseWindow();
+
     /*!
      * \brief sets the application service object.
      *
@@ -233,12 +266,44 @@ protected slots:
 private slots:
     void slotOpenDocument();
     void showFrontPageView();
+    void windowTypeUrnResolved(const QUrl &url, const QString &urn);
+    /*!
+     * \brief Closes this window, quits if no other window of this process
+     * shows a document or the front page
+     */
+    void closeWindow();
+    /*!
+     * \brief Shows the window once its type is known, or when tracker
+     * did not answer in #WindowTypeTimeout
+     */
+    void showWindow();
 
 private:
     Q_DISABLE_COPY(ApplicationWindow)
 
     void showBannerInformation(const QString &message);
 
+    /*!
+     * \brief Opens the document, or the front page for an empty name, in a
+     * new window of this process.
+     */
+    void openWindow(const QString &fileName);
+
+    static ApplicationWindow *frontPageWindow();
+
+    bool hasContent() const;
+
+    /*!
+     * \brief Hands the document page over to #DocumentPageCache
+     */
+    void releasePage();
+
+    /*!
+     * \brief Asks tracker for the urn of given file without blocking and
+     * turns the window into a quick viewer sheet if the file is not indexed
+     */
+    void requestWindowType(const QString &path);
+
     /*!
     * \brief Current document page
     *
@@ -264,10 +329,17 @@ private:
     MApplicationWindow *appWindow;
     bool firstInstance;
     bool frontPageLaunched;
-    QSettings *officeToolsSettings;
     ApplicationService *applicationService;
     ViewerInterface *viewerInterface;
     MBanner *infoBanner;
+    QUrl windowTypeUrl;
+    //! Window opened by openWindow, which owns its MApplicationWindow
+    bool ownsAppWindow;
+    bool windowClosed;
+    //! Checks left for the document page to appear before it is loaded
+    int displayWait;
+    //! The window is shown when the window type has been resolved
+    bool showPending;
 };
 
 #endif
@@ -35,19 +35,30 @@ HEADERS +=  \
     applicationwindow.h \
     basepagewidget.h \
     documentdetailview.h \
+    documentfilterindex.h \
+    documentimageloader.h \
     documentlistitem.h \
     documentlistmodel.h \
     documentlistpage.h \
+    documentpagecache.h \
     documentpage.h \
     findtoolbar.h \
+    idletimer.h \
+    instanceregistry.h \
     jumptotoolbar.h \
+    mimetyperegistry.h \
     misc.h \
+    pluginmanifest.h \
+    officelog.h \
     officethumbprovider.h \
     officeviewerbase.h \
     pageindicator.h \
+    perfcounters.h \
+    readingposition.h \
     thumbpagelayoutpolicy.h \
     thumbprovider.h \
     thumbwidget.h \
+    tracepoint.h \
     trackerutils.h \
     zoomlevel.h \
     quickviewertoolbar.h
@@ -59,17 +70,28 @@ SOURCES += \
     applicationwindow.cpp \
     basepagewidget.cpp \
     documentdetailview.cpp \
+    documentfilterindex.cpp \
+    documentimageloader.cpp \
     documentlistitem.cpp \
     documentlistmodel.cpp \
     documentlistpage.cpp \
+    documentpagecache.cpp \
     documentpage.cpp \
     findtoolbar.cpp \
+    idletimer.cpp \
+    instanceregistry.cpp \
     jumptotoolbar.cpp \
+    mimetyperegistry.cpp \
     misc.cpp \
+    pluginmanifest.cpp \
+    officelog.cpp \
     officethumbprovider.cpp \
     pageindicator.cpp \
+    perfcounters.cpp \
+    readingposition.cpp \
     thumbprovider.cpp \
     thumbwidget.cpp \
+    tracepoint.cpp \
     trackerutils.cpp \
     zoomlevel.cpp \
     quickviewertoolbar.cpp
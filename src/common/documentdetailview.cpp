@@ -84,8 +84,24 @@ void DocumentDetailView::parseDocumentDetail()
     QFileInfo fileInfo(m_documentPath);
     m_fileTitle = fileInfo.completeBaseName();
 
-    DocumentDetails *details = TrackerUtils::Instance().documentDetailsFromUrl(filePath);
+    // The page is filled in when tracker has answered, possibly before requestDocumentDetails returns
+    TrackerUtils &tracker = TrackerUtils::Instance();
+    connect(&tracker, SIGNAL(documentDetailsReady(QString, const DocumentDetails *)),
+            this, SLOT(documentDetailsResolved(QString, const DocumentDetails *)));
+    m_trackerUrl = filePath;
+    tracker.requestDocumentDetails(filePath);
+}
+
+void DocumentDetailView::documentDetailsResolved(const QString &url, const DocumentDetails *details)
+{
+    if (url != m_trackerUrl) {
+        return;
+    }
+    disconnect(&TrackerUtils::Instance(), SIGNAL(documentDetailsReady(QString, const DocumentDetails *)),
+               this, SLOT(documentDetailsResolved(QString, const DocumentDetails *)));
+
     if (details) {
+        QFileInfo fileInfo(m_documentPath);
         MLocale locale;
         m_downloadDate = locale.formatDateTime(details->created, MLocale::DateShort, MLocale::TimeShort);
 
@@ -102,7 +118,6 @@ void DocumentDetailView::parseDocumentDetail()
         }
 
         m_mimeType = qtTrId(Misc::getFileTypeFromMime(details->mimeType, fileInfo.suffix()).toLatin1().data());
-        delete details;
     }
 
     loadDocumentDetails();
@@ -29,6 +29,7 @@
 #include <common_export.h>
 
 class MBasicListItem;
+struct DocumentDetails;
 
 class COMMON_EXPORT DocumentDetailView: public MApplicationPage
 {
@@ -57,9 +58,12 @@ private:
 
     QString m_strByteSize;
     QString m_lastAccessedDate;
+    //! Url the details were requested with from tracker
+    QString m_trackerUrl;
 
 private slots:
     void pixmapLoaded();
+    void documentDetailsResolved(const QString &url, const DocumentDetails *details);
 
 };
 
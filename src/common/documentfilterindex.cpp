@@ -0,0 +1,140 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include "documentfilterindex.h"
+
+#include <QStringList>
+
+DocumentFilterIndex::DocumentFilterIndex()
+{
+}
+
+void DocumentFilterIndex::insert(const QString &id, const QString &text)
+{
+    const QString lowerText = text.toLower();
+
+    if (m_texts.contains(id)) {
+        const QString oldText = m_texts.value(id);
+        if (oldText == lowerText) {
+            return;
+        }
+        removeGrams(id, oldText);
+    }
+
+    m_texts.insert(id, lowerText);
+    addGrams(id, lowerText);
+}
+
+void DocumentFilterIndex::remove(const QString &id)
+{
+    if (!m_texts.contains(id)) {
+        return;
+    }
+
+    removeGrams(id, m_texts.take(id));
+}
+
+void DocumentFilterIndex::clear()
+{
+    m_texts.clear();
+    m_postings.clear();
+}
+
+bool DocumentFilterIndex::contains(const QString &id) const
+{
+    return m_texts.contains(id);
+}
+
+int DocumentFilterIndex::count() const
+{
+    return m_texts.count();
+}
+
+QSet<QString> DocumentFilterIndex::match(const QString &filter) const
+{
+    const QString lowerFilter = filter.toLower();
+
+    if (lowerFilter.isEmpty()) {
+        return m_texts.keys().toSet();
+    }
+
+    if (lowerFilter.length() <= MaxGramLength) {
+        return m_postings.value(lowerFilter);
+    }
+
+    // Start from the rarest trigram to keep the intersection small
+    QList<const QSet<QString> *> postings;
+    for (int i = 0; i + MaxGramLength <= lowerFilter.length(); i++) {
+        QHash<QString, QSet<QString> >::const_iterator it = m_postings.constFind(lowerFilter.mid(i, MaxGramLength));
+        if (it == m_postings.constEnd()) {
+            return QSet<QString>();
+        }
+        postings << &it.value();
+    }
+
+    int rarest = 0;
+    for (int i = 1; i < postings.count(); i++) {
+        if (postings.at(i)->count() < postings.at(rarest)->count()) {
+            rarest = i;
+        }
+    }
+
+    QSet<QString> result;
+    foreach (const QString &id, *postings.at(rarest)) {
+        bool candidate = true;
+        for (int i = 0; i < postings.count() && candidate; i++) {
+            candidate = postings.at(i)->contains(id);
+        }
+
+        // All trigrams present does not yet mean they are adjacent
+        if (candidate && m_texts.value(id).contains(lowerFilter)) {
+            result.insert(id);
+        }
+    }
+
+    return result;
+}
+
+void DocumentFilterIndex::addGrams(const QString &id, const QString &text)
+{
+    for (int length = 1; length <= MaxGramLength; length++) {
+        for (int i = 0; i + length <= text.length(); i++) {
+            m_postings[text.mid(i, length)].insert(id);
+        }
+    }
+}
+
+void DocumentFilterIndex::removeGrams(const QString &id, const QString &text)
+{
+    for (int length = 1; length <= MaxGramLength; length++) {
+        for (int i = 0; i + length <= text.length(); i++) {
+            QHash<QString, QSet<QString> >::iterator it = m_postings.find(text.mid(i, length));
+            if (it != m_postings.end()) {
+                it.value().remove(id);
+                if (it.value().isEmpty()) {
+                    m_postings.erase(it);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef DOCUMENTFILTERINDEX_H
+#define DOCUMENTFILTERINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include <common_export.h>
+
+/*!
+ * \class DocumentFilterIndex
+ * \brief N-gram index for the live filtering of the document list.
+ *
+ * Every indexed text is stored under all its one, two and three character
+ * substrings, compared case insensitively. Filters of up to three characters
+ * are answered with a single lookup, longer ones by intersecting the
+ * postings of their trigrams and verifying the few remaining candidates.
+ * The index is updated per document, so it can follow the live query.
+ */
+class COMMON_EXPORT DocumentFilterIndex
+{
+public:
+    DocumentFilterIndex();
+
+    /*!
+     * \brief Adds or replaces the text of a document
+     * \param id Identifier of the document
+     * \param text Text the filter is matched against
+     */
+    void insert(const QString &id, const QString &text);
+
+    /*!
+     * \brief Removes a document from the index
+     * \param id Identifier of the document
+     */
+    void remove(const QString &id);
+
+    /*!
+     * \brief Removes all documents from the index
+     */
+    void clear();
+
+    /*!
+     * \brief Returns whether a document is indexed
+     */
+    bool contains(const QString &id) const;
+
+    /*!
+     * \brief Returns the number of indexed documents
+     */
+    int count() const;
+
+    /*!
+     * \brief Finds the documents containing given text
+     * \param filter Text to search for, compared case insensitively
+     * \return Identifiers of the matching documents. All documents for an empty filter.
+     */
+    QSet<QString> match(const QString &filter) const;
+
+private:
+    static const int MaxGramLength = 3;
+
+    void addGrams(const QString &id, const QString &text);
+    void removeGrams(const QString &id, const QString &text);
+
+    //! Indexed text (lower case) by id
+    QHash<QString, QString> m_texts;
+    //! Ids of the documents containing the n-gram
+    QHash<QString, QSet<QString> > m_postings;
+};
+
+#endif // DOCUMENTFILTERINDEX_H
@@ -0,0 +1,244 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QUrl>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QCryptographicHash>
+
+#include <poppler-qt4.h>
+
+#include "documentimageloader.h"
+#include "documentlistmodel.h"
+#include "definitions.h"
+#include "ViewerInterface.h"
+
+namespace
+{
+    struct PictureRequest {
+        QString url;
+        bool pdf;
+    };
+
+    QImage renderPdf(const QString &path, const QSize &size)
+    {
+        QImage image;
+        Poppler::Document *document = Poppler::Document::load(path);
+        if (document && !document->isLocked() && document->numPages() > 0) {
+            document->setRenderHint(Poppler::Document::Antialiasing, true);
+            document->setRenderHint(Poppler::Document::TextAntialiasing, true);
+            Poppler::Page *page = document->page(0);
+            if (page) {
+                const QSizeF pageSize = page->pageSizeF();
+                const qreal longest = qMax(pageSize.width(), pageSize.height());
+                if (longest > 0) {
+                    // Page size is in points, i.e. at 72 dpi
+                    const qreal dpi = 72.0 * qMax(size.width(), size.height()) / longest;
+                    image = page->renderToImage(dpi, dpi);
+                }
+                delete page;
+            }
+        }
+        delete document;
+        return image;
+    }
+}
+
+class DocumentImageLoader::Private
+{
+public:
+    Private()
+    : viewer(0)
+    , stopLoading(false)
+    {}
+
+    //! Index of the first request that can be served now, -1 if none
+    int nextRequest() const
+    {
+        // Office documents wait in the queue until the viewer plugin is there
+        for (int i = 0; i < queue.count(); ++i) {
+            if (queue.at(i).pdf || viewer) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    ViewerInterface *viewer;
+    bool stopLoading;
+
+    QList<PictureRequest> queue;
+    QSet<QString> failed;
+    QMutex mutex;
+};
+
+DocumentImageLoader::DocumentImageLoader()
+: d(new Private())
+{
+    QObject::moveToThread(this);
+    connect(this, SIGNAL(pictureQueued()), SLOT(loadQueuedPicture()));
+}
+
+DocumentImageLoader::~DocumentImageLoader()
+{
+    delete d;
+}
+
+QString DocumentImageLoader::thumbnailPath(const QString &url)
+{
+    // Location and naming from the freedesktop.org thumbnail specification
+    const QByteArray hash = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Md5).toHex();
+    return QDir::homePath() + "/.thumbnails/normal/" + QString::fromLatin1(hash) + ".png";
+}
+
+void DocumentImageLoader::setViewer(ViewerInterface *viewer)
+{
+    QMutexLocker lock(&d->mutex);
+    d->viewer = viewer;
+    const bool pending = d->nextRequest() >= 0;
+    lock.unlock();
+
+    if (pending) {
+        emit pictureQueued();
+    }
+}
+
+bool DocumentImageLoader::requestPicture(const QString &url, int category)
+{
+    PictureRequest request;
+    request.url = url;
+
+    switch (category) {
+    case DocumentListModel::PDF:
+        request.pdf = true;
+        break;
+    case DocumentListModel::DOCUMENT:
+    case DocumentListModel::OPEN_DOC_TEXT:
+    case DocumentListModel::PRESENTATION:
+    case DocumentListModel::OPEN_DOC_PPT:
+    case DocumentListModel::SPREADSHEET:
+    case DocumentListModel::OPEN_DOC_XLS:
+        request.pdf = false;
+        break;
+    default:
+        return false;
+    }
+
+    QMutexLocker lock(&d->mutex);
+    if (d->failed.contains(url)) {
+        return false;
+    }
+    for (int i = 0; i < d->queue.count(); ++i) {
+        if (d->queue.at(i).url == url) {
+            d->queue.removeAt(i);
+            break;
+        }
+    }
+    d->queue.prepend(request);
+    lock.unlock();
+
+    emit pictureQueued();
+    return true;
+}
+
+void DocumentImageLoader::loadPictures(const QStringList &urls)
+{
+    const QSet<QString> visible = urls.toSet();
+
+    QMutexLocker lock(&d->mutex);
+    QList<PictureRequest>::iterator i = d->queue.begin();
+    while (i != d->queue.end()) {
+        if (visible.contains(i->url)) {
+            ++i;
+        } else {
+            i = d->queue.erase(i);
+        }
+    }
+}
+
+void DocumentImageLoader::stopBackgroundLoading()
+{
+    QMutexLocker lock(&d->mutex);
+    d->stopLoading = true;
+}
+
+void DocumentImageLoader::loadQueuedPicture()
+{
+    QMutexLocker lock(&d->mutex);
+    if (d->stopLoading) {
+        return;
+    }
+    const int next = d->nextRequest();
+    if (next < 0) {
+        return;
+    }
+    ViewerInterface *viewer = d->viewer;
+    const PictureRequest request = d->queue.takeAt(next);
+    lock.unlock();
+
+    const QSize size(ThumbnailNormalSize, ThumbnailNormalSize);
+    const QString path = QUrl(request.url).toLocalFile();
+    const QString mtime = QString::number(QFileInfo(path).lastModified().toTime_t());
+    const QString cachePath = thumbnailPath(request.url);
+
+    QImage image(cachePath);
+    if (image.isNull() || image.text("Thumb::MTime") != mtime) {
+        image = request.pdf ? renderPdf(path, size) : viewer->documentThumbnail(path, size);
+
+        if (!image.isNull()) {
+            image.setText("Thumb::URI", request.url);
+            image.setText("Thumb::MTime", mtime);
+            // Written under a temporary name so that nobody reads a partial file
+            QDir().mkpath(QFileInfo(cachePath).path());
+            const QString tempPath = cachePath + ".office-tools";
+            if (image.save(tempPath, "PNG")) {
+                QFile::remove(cachePath);
+                QFile::rename(tempPath, cachePath);
+            }
+        }
+    }
+
+    if (image.isNull()) {
+        qDebug() << __PRETTY_FUNCTION__ << "no picture for" << request.url;
+        QMutexLocker failedLock(&d->mutex);
+        d->failed.insert(request.url);
+    } else {
+        emit pictureLoaded(request.url, image);
+    }
+
+    lock.relock();
+    const bool pending = d->nextRequest() >= 0;
+    lock.unlock();
+
+    // One picture per event so that stopping is not delayed by a long queue
+    if (pending) {
+        QMetaObject::invokeMethod(this, "loadQueuedPicture", Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef DOCUMENTIMAGELOADER_H
+#define DOCUMENTIMAGELOADER_H
+
+#include <QThread>
+#include <QImage>
+#include <QStringList>
+
+#include <common_export.h>
+
+class ViewerInterface;
+
+/*!
+ * \class DocumentImageLoader
+ * \brief Creates preview pictures for the front page list in background
+ *
+ * PDF documents get their first page rendered with Poppler, office documents
+ * the preview the viewer plugin finds in the file. Pictures are kept in the
+ * shared freedesktop thumbnail cache, so they are reused by later runs and
+ * by other applications as long as the document is not modified.
+ */
+class COMMON_EXPORT DocumentImageLoader : public QThread
+{
+    Q_OBJECT
+
+public:
+    DocumentImageLoader();
+    ~DocumentImageLoader();
+
+    /*!
+     * \brief Returns the file the picture of given document is cached in
+     * \param url The url of the document
+     */
+    static QString thumbnailPath(const QString &url);
+
+    /*!
+     * \brief Sets the viewer plugin used for the office documents. Until it
+     * is set only PDF documents are handled.
+     */
+    void setViewer(ViewerInterface *viewer);
+
+    /*!
+     * \brief Queues the creation of a picture, latest requests are served first
+     * \param url The url of the document
+     * \param category DocumentListModel::DocumentCategory of the document
+     * \return false if there will be no picture for the document
+     */
+    bool requestPicture(const QString &url, int category);
+
+    /*!
+     * \brief Drops the queued requests which are not in given list, called
+     * once the list stops so the rows panned past are not loaded.
+     * \param urls Urls of the documents now visible
+     */
+    void loadPictures(const QStringList &urls);
+
+public slots:
+    void stopBackgroundLoading();
+
+signals:
+    /*!
+     * \brief Emitted when a picture is available
+     * \param url The url of the document
+     * \param image The picture, at most ThumbnailListSize
+     */
+    void pictureLoaded(const QString &url, const QImage &image);
+
+    void pictureQueued();
+
+private slots:
+    void loadQueuedPicture();
+
+private:
+    class Private;
+    Private * const d;
+};
+
+#endif // DOCUMENTIMAGELOADER_H
@@ -23,6 +23,7 @@
 
 #include "documentlistmodel.h"
 #include <QStringList>
+#include <QSet>
 #include <QSettings>
 #include <QFileInfo>
 #include <QUrl>
@@ -37,6 +38,7 @@
 #include <MCalendar>
 #include <MLocale>
 #include "misc.h"
+#include "mimetyperegistry.h"
 #include "trackerutils.h"
 
 #define WEEK  (7)
@@ -81,6 +83,8 @@ void DocumentListModel::liveModelQueryFinished()
     connect(model(), SIGNAL(rowsRemoved(QModelIndex, int, int)),
             this, SLOT(handleRowsRemoved(QModelIndex, int, int)));
 
+    cacheDocuments(0, model()->rowCount() - 1);
+    indexDocuments(0, model()->rowCount() - 1);
     recalculateGroups();
 
     emit liveQueryFinished();
@@ -96,8 +100,8 @@ DocumentListModel::~DocumentListModel()
 void DocumentListModel::handleDataChanged(const QModelIndex &topLeft,
                                          const QModelIndex &bottomRight)
 {
-    Q_UNUSED(topLeft);
-    Q_UNUSED(bottomRight);
+    cacheDocuments(topLeft.row(), bottomRight.row());
+    indexDocuments(topLeft.row(), bottomRight.row());
 
     emit layoutAboutToBeChanged();
     //We get repeated dataChanged signal. We can live with one signal
@@ -117,6 +121,14 @@ void DocumentListModel::handleRowsAboutToBeRemoved(const QModelIndex &index,
     Q_UNUSED(index);
     qDebug() << __PRETTY_FUNCTION__;
     beginRemoveRows(QModelIndex(), start, end, false);
+    for(int i = start; i <= end; i++) {
+        TrackerUtils::Instance().forgetDocument(liveQuery->model()->index(i, 0).data().toString());
+
+        QString urn = liveQuery->model()->index(i, 5).data().toString();
+        filterIndex.remove(urn);
+        typeLabelDocuments[documentTypeLabels.take(urn)].remove(urn);
+        liveFilterMatches.remove(urn);
+    }
     if(pathsToMonitor.count() != 0)
     {
         for(int i = start; i <= end; i++)
@@ -180,14 +192,77 @@ void DocumentListModel::handleRowsAboutToBeInserted(const QModelIndex &index, in
 void DocumentListModel::handleRowsInserted(const QModelIndex &index, int start, int end)
 {
     Q_UNUSED(index);
-    Q_UNUSED(start);
-    Q_UNUSED(end);
     qDebug() << __PRETTY_FUNCTION__;
+    cacheDocuments(start, end);
+    indexDocuments(start, end);
     recalculateGroups();
     endInsertRows();
     emit updateListPage();
 }
 
+void DocumentListModel::cacheDocuments(int start, int end)
+{
+    QAbstractItemModel *liveModel = liveQuery->model();
+
+    for(int i = start; i <= end; i++) {
+        TrackerUtils::Instance().cacheDocument(liveModel->index(i, 0).data().toString(),
+                                               liveModel->index(i, 5).data().toString(),
+                                               liveModel->index(i, 1).data().toDateTime(),
+                                               !liveModel->index(i, 3).data().toString().isNull(),
+                                               liveModel->index(i, 7).data().toBool());
+    }
+}
+
+void DocumentListModel::indexDocuments(int start, int end)
+{
+    QAbstractItemModel *liveModel = liveQuery->model();
+    static QFileInfo fileInfo;
+
+    for(int i = start; i <= end; i++) {
+        QString urn = liveModel->index(i, 5).data().toString();
+        fileInfo.setFile(QUrl::fromPercentEncoding(liveModel->index(i, 0).data().toString().toUtf8()));
+
+        filterIndex.insert(urn, fileInfo.completeBaseName());
+
+        // The labels are translated when the filter is applied
+        const QString typeLabel = Misc::getFileTypeFromMime(liveModel->index(i, 2).data().toString(),
+                                                            fileInfo.suffix());
+        const QString oldTypeLabel = documentTypeLabels.value(urn);
+        if(oldTypeLabel != typeLabel) {
+            typeLabelDocuments[oldTypeLabel].remove(urn);
+            typeLabelDocuments[typeLabel].insert(urn);
+            documentTypeLabels.insert(urn, typeLabel);
+        }
+    }
+
+    if(!liveFilterText.isEmpty()) {
+        matchLiveFilter();
+    }
+}
+
+void DocumentListModel::setLiveFilter(const QString &text)
+{
+    liveFilterText = text;
+    if(liveFilterText.isEmpty()) {
+        liveFilterMatches.clear();
+    } else {
+        matchLiveFilter();
+    }
+}
+
+void DocumentListModel::matchLiveFilter()
+{
+    liveFilterMatches = filterIndex.match(liveFilterText);
+
+    // There are only a few document types, their labels are matched directly
+    QHash<QString, QSet<QString> >::const_iterator it = typeLabelDocuments.constBegin();
+    for(; it != typeLabelDocuments.constEnd(); ++it) {
+        if(!it.key().isEmpty() && qtTrId(it.key().toLatin1().data()).contains(liveFilterText, Qt::CaseInsensitive)) {
+            liveFilterMatches += it.value();
+        }
+    }
+}
+
 int DocumentListModel::groupCount() const
 {
     return groups.count();
@@ -268,12 +343,18 @@ QVariant DocumentListModel::itemData(int row, int group, int role) const
     int flatRow = row;
 
     if (group >= 0 && row >= 0) {
-        flatRow = rowToGroupReference.values(group).at(row);
+        flatRow = groupRowToFlatRow(group, row);
     }
 
     Q_ASSERT(flatRow >= 0);
     Q_ASSERT(flatRow < liveQuery->model()->rowCount());
 
+    // asked for every row on each key press of the live filter
+    if (role == DocumentListLiveFilterMatchRole) {
+        return QVariant::fromValue(QString((liveFilterText.isEmpty() ||
+                                            liveFilterMatches.contains(liveQuery->model()->index(flatRow, 5).data().toString())) ? "1" : "0"));
+    }
+
     static QFileInfo fileInfo;
     QModelIndex index = liveQuery->model()->index(flatRow, 0);
     fileInfo.setFile(QUrl::fromPercentEncoding((index.data().toString()).toUtf8()));
@@ -282,8 +363,9 @@ QVariant DocumentListModel::itemData(int row, int group, int role) const
         DocumentListEntry entry;
         entry.url = index.data().toString();
         entry.isFavorite = !(index.sibling(flatRow, 3).data().toString().isNull());
-        entry.documentType = Misc::getFileTypeFromMime(index.sibling(flatRow, 2).data().toString(), fileInfo.suffix());
-        entry.documentCat = getDocumentCategory(entry.documentType);
+        const QString mimeType = index.sibling(flatRow, 2).data().toString();
+        entry.documentType = MimeTypeRegistry::labelId(mimeType, fileInfo.suffix());
+        entry.documentCat = MimeTypeRegistry::category(mimeType);
         entry.documentName = fileInfo.completeBaseName();
 //        entry.lastAccessed = index.sibling(flatRow, 1).data().toDateTime();
         return QVariant::fromValue(entry);
@@ -301,6 +383,18 @@ QVariant DocumentListModel::itemData(int row, int group, int role) const
     return QVariant();
 }
 
+int DocumentListModel::groupRowToFlatRow(int group, int row) const
+{
+    // same order as QHash::values(group) without building the list
+    QHash<int, int>::const_iterator it = rowToGroupReference.constFind(group);
+    for (int i = 0; i < row && it != rowToGroupReference.constEnd() && it.key() == group; i++) {
+        ++it;
+    }
+
+    Q_ASSERT(it != rowToGroupReference.constEnd() && it.key() == group);
+    return it.value();
+}
+
 void DocumentListModel::updateData(const QModelIndex &first, const QModelIndex &last)
 {
     emit dataChanged(first, last);
@@ -477,7 +571,7 @@ void DocumentListModel::makeTypeGroups()
     int row = 0;
     QModelIndex index = sourceModel->index(0, 2);
     while (index.isValid()) {
-        QString group(documentCatString(getDocumentCategory(Misc::getFileTypeFromMime(index.data().toString())),
+        QString group(documentCatString(MimeTypeRegistry::category(index.data().toString()),
                                         !(index.sibling(row, 3).data().toString().isNull())));
 
         if(!groups.contains(group)) {
@@ -552,33 +646,7 @@ QString DocumentListModel::documentCatString(int cat, bool isFavorite) const
 
 int DocumentListModel::getDocumentCategory(QString const &documentType) const
 {
-    if( (QString::compare("qtn_comm_filetype_doc", documentType) == 0) ||
-        (QString::compare("qtn_comm_filetype_rtf", documentType) == 0) ||
-        (QString::compare("qtn_comm_filetype_docx",documentType) == 0)) {
-        return DOCUMENT;
-    } else if(QString::compare("qtn_comm_filetype_odt", documentType) == 0) {
-        return OPEN_DOC_TEXT;
-    } else if(QString::compare("qtn_comm_filetype_txt", documentType) == 0) {
-        return TEXT;
-    } else if(QString::compare("qtn_comm_filetype_pdf", documentType) == 0) {
-        return PDF;
-    } else if(
-        (QString::compare("qtn_comm_filetype_ppt", documentType) == 0) ||
-        (QString::compare("qtn_comm_filetype_pps", documentType) == 0) ||
-        (QString::compare("qtn_comm_filetype_pptx",documentType) == 0)||
-        (QString::compare("qtn_comm_filetype_ppsx",documentType) == 0)) {
-        return PRESENTATION;
-    } else if(QString::compare("qtn_comm_filetype_odp", documentType) == 0) {
-        return OPEN_DOC_PPT;
-    } else if(
-        (QString::compare("qtn_comm_filetype_xls", documentType) == 0) ||
-        (QString::compare("qtn_comm_filetype_xlsx",documentType) == 0)) {
-        return SPREADSHEET;
-    } else if(QString::compare("qtn_comm_filetype_ods", documentType) == 0) {
-        return OPEN_DOC_XLS;
-    }
-
-    return UNKNOWNTYPE;
+    return MimeTypeRegistry::categoryForLabel(documentType);
 }
 
 QString DocumentListModel::documentUri(QModelIndex &index) const
@@ -644,21 +712,27 @@ bool DocumentListModel::documentIsFavorite(QString uri)
 
 void DocumentListModel::setFavourite(int group, int row) const
 {
-    setFavourite(documentUri(group, row));
-}
-void DocumentListModel::setFavourite(QString uri)
-{
+    QString uri = documentUri(group, row);
     if(uri.isEmpty())
         return;
-    qDebug() << __PRETTY_FUNCTION__ << uri;
 
-    if(documentIsFavorite(uri)) {
+    // The live model already knows the state, no need to ask tracker
+    if(documentIsFavorite(group, row)) {
         TrackerUtils::Instance().unmarkItemAsFavorite(uri);
     } else {
         TrackerUtils::Instance().markItemAsFavorite(uri);
     }
 }
 
+void DocumentListModel::setFavourite(QString uri)
+{
+    if(uri.isEmpty())
+        return;
+    qDebug() << __PRETTY_FUNCTION__ << uri;
+
+    TrackerUtils::Instance().toggleItemFavorite(uri);
+}
+
 void DocumentListModel::notifyOnDeleteFinished(QStringList list)
 {
     pathsToMonitor = list;
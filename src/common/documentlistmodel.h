@@ -35,6 +35,8 @@
 #include <MAbstractItemModel>
 #include <common_export.h>
 
+#include "documentfilterindex.h"
+
 // Structure which contain data for each row
 struct COMMON_EXPORT DocumentListEntry {
     QString uri;
@@ -62,6 +64,8 @@ public:
         DocumentListTypeRole,
         DocumentListFavRole,
         DocumentListLiveFilterRole,
+        //! "1" for documents matching the filter set with setLiveFilter, "0" otherwise
+        DocumentListLiveFilterMatchRole,
     };
 
     enum DocumentListGroups {
@@ -109,6 +113,13 @@ public:
     void recalculateGroups();
     void notifyOnDeleteFinished(QStringList list);
 
+    /*!
+     * \brief Sets the text used by DocumentListLiveFilterMatchRole. The matching
+     * documents are looked up from an index kept up to date with the live query.
+     * \param text Text searched from the document names and type labels
+     */
+    void setLiveFilter(const QString &text);
+
     QAbstractItemModel *model() const
     {
         return liveQuery->model();
@@ -154,6 +165,27 @@ private:
 
     QString createTimeStampGroups(const QDateTime &laDate);
 
+    //! The row of the live query shown at given row of a group
+    int groupRowToFlatRow(int group, int row) const;
+
+    //! Feeds the rows of the live query to the TrackerUtils cache
+    void cacheDocuments(int start, int end);
+
+    //! Updates the live filter index for the rows of the live query
+    void indexDocuments(int start, int end);
+
+    //! Finds the documents whose name or type label contains the live filter text
+    void matchLiveFilter();
+
+    //! Names of the documents
+    DocumentFilterIndex filterIndex;
+    //! Type label id by document urn
+    QHash<QString, QString> documentTypeLabels;
+    //! Document urns by type label id
+    QHash<QString, QSet<QString> > typeLabelDocuments;
+    QString liveFilterText;
+    QSet<QString> liveFilterMatches;
+
 signals:
     void liveQueryFinished();
     void updateListPage();
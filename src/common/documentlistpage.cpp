@@ -31,8 +31,12 @@
 #include "applicationservice.h"
 #include "definitions.h"
 #include "documentlistitem.h"
+#include "documentimageloader.h"
+#include "applicationwindow.h"
 #include "OfficeInterface.h"
+#include "pluginmanifest.h"
 #include "trackerutils.h"
+#include "idletimer.h"
 
 #include <QGraphicsLinearLayout>
 #include <QStringListModel>
@@ -46,8 +50,8 @@
 #include <QUrl>
 #include <QFutureWatcher>
 #include <QDir>
-#include <QPluginLoader>
 #include <QSettings>
+#include <QPixmapCache>
 
 #include <MAbstractCellCreator>
 #include <MSortFilterProxyModel>
@@ -58,6 +62,7 @@
 #include <MTextEdit>
 #include <MListFilter>
 #include <MPannableViewport>
+#include <MPhysics2DPanning>
 #include <MPopupList>
 #include <MWidgetAction>
 #include <MComboBox>
@@ -77,6 +82,11 @@ bool DocumentListPage::pixmapsLoaded = false;
 
 static const char * SortOrderString[] = { "SortByTime", "SortByName", "SortByType" };
 
+static QString pictureCacheKey(const QString &url)
+{
+    return "documentlistpicture:" + url;
+}
+
 class CustomSortFilterProxyModel : public MSortFilterProxyModel
 {
 protected:
@@ -92,6 +102,7 @@ protected:
 
 DocumentListPage::DocumentListPage() :
     proxyModel(0)
+    ,imageLoader(0)
     ,list(0)
     ,popuplist(0)
     ,fileLabel(NULL)
@@ -120,9 +131,7 @@ void DocumentListPage::usbModeChanged (MeeGo::QmUSBMode::Mode mode)
         proxyModelFilter->invalidate();
         switchMainView(true,qtTrId("qtn_offi_mass_storage_mode"));
     } else {
-        proxyModelFilter->setFilterRole(DocumentListModel::DocumentListLiveFilterRole);
-        proxyModelFilter->setFilterRegExp(list->filtering()->editor()->text());
-        proxyModelFilter->invalidate();
+        applyLiveFilter();
         if (proxyModelFilter->rowCount()) {
             switchMainView(false);
         } else {
@@ -133,7 +142,12 @@ void DocumentListPage::usbModeChanged (MeeGo::QmUSBMode::Mode mode)
 DocumentListPage::~DocumentListPage()
 {
     qDebug() << __PRETTY_FUNCTION__;
-    //delete imageLoader;
+    if (imageLoader) {
+        imageLoader->stopBackgroundLoading();
+        imageLoader->quit();
+        imageLoader->wait();
+        delete imageLoader;
+    }
     delete popuplist;
 }
 
@@ -185,9 +199,7 @@ void DocumentListPage::liveFilteringTextChanged()
     else if(list->filtering()->editor()->text() != "" && !list->filtering()->editor()->isOnDisplay())
         showTextEdit(true);
 
-    proxyModelFilter->setFilterRole(DocumentListModel::DocumentListLiveFilterRole);
-    proxyModelFilter->setFilterRegExp(list->filtering()->editor()->text());
-    proxyModelFilter->invalidate();
+    applyLiveFilter();
 
     if(0 == proxyModelFilter->rowCount()) {
         switchMainView(true, qtTrId("qtn_offi_no_documents"));
@@ -196,6 +208,15 @@ void DocumentListPage::liveFilteringTextChanged()
     }
 }
 
+void DocumentListPage::applyLiveFilter()
+{
+    // The model answers from its filter index, the proxy only compares a flag per row
+    model->setLiveFilter(list->filtering()->editor()->text());
+    proxyModelFilter->setFilterRole(DocumentListModel::DocumentListLiveFilterMatchRole);
+    proxyModelFilter->setFilterFixedString("1");
+    proxyModelFilter->invalidate();
+}
+
 QString DocumentListPage::highlightText() const
 {
     if (!list || !list->filtering() || !list->filtering()->enabled()) {
@@ -353,6 +374,10 @@ public:
 
         QPixmap *ico = 0;
         int cat = entry.documentCat;
+        // The type icon is shown until the picture of the document is loaded
+        if (m_page->loadPicture(listItem, entry.url, cat)) {
+            cat = DocumentListModel::UNKNOWNTYPE;
+        }
         switch (cat) {
             case DocumentListModel::DOCUMENT:
                 ico = (QPixmap *)MTheme::pixmap("icon-m-content-word", QSize(88, 88));
@@ -402,9 +427,83 @@ private:
     DocumentListPage *m_page;
 };
 
+bool DocumentListPage::loadPicture(DocumentListItem *item, const QString &url, int category)
+{
+    // Items are recycled, forget the document the item showed before
+    const QString previousUrl = item->property("documentUrl").toString();
+    if (previousUrl != url && pictureItems.value(previousUrl) == item) {
+        pictureItems.remove(previousUrl);
+    }
+    item->setProperty("documentUrl", url);
+
+    QPixmap picture;
+    if (QPixmapCache::find(pictureCacheKey(url), &picture)) {
+        item->imageWidget()->setPixmap(picture);
+        return true;
+    }
+
+    if (imageLoader && imageLoader->requestPicture(url, category)) {
+        pictureItems.insert(url, item);
+    }
+    return false;
+}
+
+void DocumentListPage::pictureLoaded(const QString &url, const QImage &image)
+{
+    QPointer<DocumentListItem> item = pictureItems.value(url);
+    if (!item || item->property("documentUrl").toString() != url) {
+        pictureItems.remove(url);
+        return;
+    }
+
+    // Pixmaps are only made for the rows on screen, others get theirs from
+    // the disk cache when they are shown again
+    if (!item->isOnDisplay()) {
+        return;
+    }
+    pictureItems.remove(url);
+
+    const QPixmap picture = QPixmap::fromImage(image.scaled(DocumentListIconSize, DocumentListIconSize,
+                                                            Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    QPixmapCache::insert(pictureCacheKey(url), picture);
+    item->imageWidget()->setPixmap(picture);
+}
+
 void DocumentListPage::loadPicturesInVisibleItems()
 {
-    //imageLoader->loadPictures(list->firstVisibleItem(), list->lastVisibleItem());
+    if (!imageLoader) {
+        return;
+    }
+
+    QStringList urls;
+    QHash<QString, QPointer<DocumentListItem> >::iterator i = pictureItems.begin();
+    while (i != pictureItems.end()) {
+        if (!i.value()) {
+            i = pictureItems.erase(i);
+        } else {
+            if (i.value()->isOnDisplay()) {
+                urls << i.key();
+            }
+            ++i;
+        }
+    }
+    imageLoader->loadPictures(urls);
+}
+
+void DocumentListPage::loadPictureViewer()
+{
+    // Loading the plugin blocks, which would stop a kinetic pan
+    if (listViewport->physics()->inMotion()) {
+        IdleTimer::singleShot(ListPictureViewerLoadDelay, this, SLOT(loadPictureViewer()));
+        return;
+    }
+
+    QString error;
+    ViewerInterface *viewer = ApplicationWindow::viewerPlugin(error);
+    if (!viewer) {
+        qWarning() << "No pictures for office documents:" << error;
+    }
+    imageLoader->setViewer(viewer);
 }
 
 void DocumentListPage::setPlainListModel()
@@ -757,12 +856,17 @@ void DocumentListPage::initUI()
     list->filtering()->setEnabled(true);
     proxyModelFilter = list->filtering()->proxy();
     list->filtering()->editor()->setVisible(false);
-//    Uncomment below two lines to get live filtering feature back.
-//    connect(list->filtering(), SIGNAL(listPannedUpFromTop()), this, SLOT(filteringVKB()));
-//    connect(list->filtering()->editor(), SIGNAL(textChanged()), this, SLOT(liveFilteringTextChanged()));
+    connect(list->filtering(), SIGNAL(listPannedUpFromTop()), this, SLOT(filteringVKB()));
+    connect(list->filtering()->editor(), SIGNAL(textChanged()), this, SLOT(liveFilteringTextChanged()));
     listViewport->setWidget(list);
     list->hide();
 
+    imageLoader = new DocumentImageLoader();
+    connect(imageLoader, SIGNAL(pictureLoaded(const QString &, const QImage &)),
+            this, SLOT(pictureLoaded(const QString &, const QImage &)));
+    connect(listViewport, SIGNAL(panningStopped()), this, SLOT(loadPicturesInVisibleItems()));
+    imageLoader->start(QThread::LowestPriority);
+
     setCentralWidget(panel);
 
     createObjectMenuActions();
@@ -787,30 +891,7 @@ void DocumentListPage::initUI()
             SIGNAL(selectionChanged(const QItemSelection & , const QItemSelection &)),
             SLOT(selectionChanged(const QItemSelection & , const QItemSelection &)));
 
-    const QDir pluginDir("/usr/lib/office-tools/plugins");
-    const QStringList plugins = pluginDir.entryList(QDir::Files);
-
-    for (int i = 0; i < plugins.size(); ++i) {
-        QPluginLoader test(pluginDir.absoluteFilePath(plugins.at(i)));
-        QObject *plug = test.instance();
-        if (plug != 0) {
-            OfficeInterface* inter = qobject_cast<OfficeInterface*>(plug);
-            if (inter) {
-                plug->setParent(this);
-
-                if (inter->pluginType() == "generic") { // Other types not supported here
-                    MAction *pluginAction = new MAction(inter->pluginName(), this);
-                    connect(pluginAction, SIGNAL(triggered()), plug, SLOT(emitOpenSignal()));
-                    connect(plug, SIGNAL(openMe(OfficeInterface*)), this, SLOT(openPlugin(OfficeInterface*)));
-                    pluginAction->setLocation(MAction::ApplicationMenuLocation);
-                    addAction(pluginAction);
-                }
-            }
-            else {
-                delete plug;
-            }
-        }
-    }
+    PluginManifest::addActions(this, "generic", this, SLOT(openPlugin(OfficeInterface*)));
 }
 
 void DocumentListPage::documentLoadingFinished()
@@ -833,6 +914,10 @@ void DocumentListPage::documentLoadingFinished()
     }
     connect(model, SIGNAL(updateListPage()), this, SLOT(slotUpdateListPage()));
     connect(model, SIGNAL(listDeleteCompleted()), this, SLOT(listUpdateFinished()));
+
+    // Office document pictures need the viewer plugin, which is not loaded
+    // before the list is up and left alone
+    IdleTimer::singleShot(ListPictureViewerLoadDelay, this, SLOT(loadPictureViewer()));
 }
 
 void DocumentListPage::slotUpdateListPage()
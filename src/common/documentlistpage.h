@@ -27,6 +27,7 @@
 #include <MApplicationPage>
 
 #include <QSortFilterProxyModel>
+#include <QPointer>
 #include <QtConcurrentRun>
 #include <MObjectMenu>
 
@@ -34,6 +35,7 @@ class ApplicationService;
 class DocumentListModel;
 class DocumentSortedModel;
 class DocumentImageLoader;
+class DocumentListItem;
 class MList;
 class MLabel;
 class MPopupList;
@@ -97,6 +99,12 @@ public:
      */
     QString highlightText() const;
 
+    /**
+     * Shows the cached picture of the document in item or requests it
+     * \return true if the picture was shown
+     */
+    bool loadPicture(DocumentListItem *item, const QString &url, int category);
+
     static bool pixmapsLoaded;
 
 public slots:
@@ -131,6 +139,8 @@ private slots:
     void longTapped(const QModelIndex &);
     void slotDataChanged();
     void pixmapLoaded();
+    void pictureLoaded(const QString &url, const QImage &image);
+    void loadPictureViewer();
     void liveFilteringTextChanged();
     void filteringVKB();
     void hideEmptyTextEdit();
@@ -148,12 +158,15 @@ private:
     bool eventFilter(QObject *obj, QEvent *event);
 
     void showTextEdit(bool show);
+    void applyLiveFilter();
     void switchMainView(bool label,QString labelText = QString());
 
     DocumentListModel *model;
     MSortFilterProxyModel *proxyModel;
     MSortFilterProxyModel *proxyModelFilter;
     DocumentImageLoader *imageLoader;
+    //! Items waiting for the picture of a document, by document url
+    QHash<QString, QPointer<DocumentListItem> > pictureItems;
     MList *list;
     MObjectMenu *objectMenu;
     MListContentItemCreator *cellCreator;
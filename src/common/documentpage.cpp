@@ -44,6 +44,7 @@
 #include <MOverlay>
 #include <MButton>
 #include <MBanner>
+#include <MScene>
 #include <MImageWidget>
 #include <QStyleOptionGraphicsItem>
 #include <QDesktopServices>
@@ -53,11 +54,13 @@
 #include "pageindicator.h"
 #include "actionpool.h"
 #include "applicationwindow.h"
+#include "mimetyperegistry.h"
 #include "documentlistmodel.h"
 #include "jumptotoolbar.h"
 #include "findtoolbar.h"
 #include "trackerutils.h"
 #include "quickviewertoolbar.h"
+#include "tracepoint.h"
 
 namespace
 {
@@ -71,15 +74,6 @@ const qreal WaitTimeOut = 1000;
 static const int NAVI_BAR_TIMEOUT = 5000;
 static const int DOUBLETAP_INTERVAL = 325;
 
-QString getDocumentUrn(QString documentName)
-{
-    QString documentUrn = TrackerUtils::Instance().urnFromUrl(QUrl::fromLocalFile(documentName));
-    if (!documentUrn.isEmpty()) {
-        TrackerUtils::Instance().updateContentAccessedProperty(documentUrn);
-    }
-    return documentUrn;
-}
-
 // This should be removed once [Harmattan - Bug 247337] [TASK] CSS background-repeat should be supported
 class ZoomBackground : public MApplicationPageView
 {
@@ -115,6 +109,8 @@ private:
 DocumentPage::DocumentPage(const QString& filePath, QGraphicsItem *parent)
     : MApplicationPage(parent)
     , currentPage(1)
+    , appMenuMFAction(0)
+    , appMenuUFAction(0)
     , m_pinchInProgress(false)
     , m_endScale(1.0)
     , m_blockRecenter(false)
@@ -140,6 +136,12 @@ DocumentPage::DocumentPage(const QString& filePath, QGraphicsItem *parent)
     , quickViewer(false)
     , m_pageView(new ZoomBackground(this))
     , m_lastZoomFactor(1.0)
+    , m_urnLookupPending(false)
+    , m_viewerTypePending(false)
+    , m_waitingForIndexing(false)
+    , m_indexingTries(0)
+    , m_zoomComboItem(ActionPool::ZoomFitToWidth)
+    , m_deferredContentCreated(false)
 {
     setView(m_pageView);
     documentName = filePath;
@@ -167,26 +169,56 @@ DocumentPage::DocumentPage(const QString& filePath, QGraphicsItem *parent)
     connect(this, SIGNAL(backButtonClicked()), this, SLOT(onClose()));
     connect(ActionPool::instance(), SIGNAL(destroyed(QObject *)), this, SLOT(removeActions()));
     connect(this, SIGNAL(loadSuccess(QString)), SLOT(updateViewerType()));
+    connect(this, SIGNAL(loadSuccess(QString)), SLOT(scheduleDeferredContent()));
+    connect(this, SIGNAL(updateZoomLevel(ActionPool::Id)), this, SLOT(updateZoomCombobox(ActionPool::Id)));
     connect(MInputMethodState::instance(), SIGNAL(inputMethodAreaChanged(const QRect &)), this, SLOT(sendVisibleAreayChanged()));
 }
 
+QVariant DocumentPage::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+    if (change == ItemSceneHasChanged) {
+        // cached pages are shown again in other windows
+        MScene *mscene = qobject_cast<MScene *>(scene());
+        MSceneManager *manager = mscene ? mscene->sceneManager() : 0;
+        if (manager && manager != m_sceneManager) {
+            // the window the page was shown in last may be gone already
+            const bool reused = isContentCreated();
+            const bool rotated = reused &&
+                                 (!m_sceneManager || m_sceneManager->orientation() != manager->orientation());
+            if (m_sceneManager) {
+                disconnect(m_sceneManager, 0, this, 0);
+            }
+            m_sceneManager = manager;
+            connect(manager, SIGNAL(orientationChanged(const M::Orientation &)),
+                    this, SIGNAL(sceneOrientationChanged(const M::Orientation &)));
+            connect(manager, SIGNAL(orientationChangeFinished(const M::Orientation &)),
+                    this, SIGNAL(sceneOrientationChangeFinished(const M::Orientation &)));
+            if (reused && applicationWindow()) {
+                styleApplicationWindow();
+            }
+            if (rotated) {
+                emit sceneOrientationChanged(manager->orientation());
+                emit sceneOrientationChangeFinished(manager->orientation());
+            }
+        }
+    }
+    return MApplicationPage::itemChange(change, value);
+}
+
 void DocumentPage::createFinalContent()
 {
     qDebug() << __PRETTY_FUNCTION__;
+    TracePoint trace("createFinalContent", "startup");
     if (!pageIndicator) {
         pageIndicator = new PageIndicator(QString(), this);
+        connect(this, SIGNAL(sceneOrientationChanged(const M::Orientation &)),
+                pageIndicator, SLOT(updatePosition(const M::Orientation &)));
     }
 
     if (documentUrn.isEmpty()) {
-        documentUrn = TrackerUtils::Instance().urnFromUrl(QUrl::fromLocalFile(documentName));
-    }
-    TrackerUtils::Instance().updateContentAccessedProperty(documentUrn);
-    if (!documentUrn.isEmpty() && !liveDocument) {
-        liveDocument = TrackerUtils::Instance().createDocumentLiveUpdate(QUrl(documentName));
-        if (liveDocument) {
-            connect(liveDocument->model(), SIGNAL(dataChanged(QModelIndex,QModelIndex)), SLOT(documentsChanged(QModelIndex, QModelIndex)));
-            connect(liveDocument->model(), SIGNAL(rowsRemoved (QModelIndex, int, int)), SIGNAL(documentCloseEvent()));
-        }
+        requestDocumentUrn();
+    } else {
+        startDocumentTracking();
     }
 
 
@@ -199,6 +231,63 @@ void DocumentPage::createFinalContent()
     grabGesture(Qt::TapAndHoldGesture);
     grabGesture(Qt::TapGesture);
 }
+
+void DocumentPage::requestDocumentUrn()
+{
+    TrackerUtils &tracker = TrackerUtils::Instance();
+    connect(&tracker, SIGNAL(urnFromUrlReady(QUrl, QString)),
+            this, SLOT(documentUrnResolved(QUrl, QString)), Qt::UniqueConnection);
+
+    // The answer may be delivered before requestUrnFromUrl returns
+    m_urnLookupPending = true;
+    tracker.requestUrnFromUrl(QUrl::fromLocalFile(documentName));
+}
+
+void DocumentPage::documentUrnResolved(const QUrl &url, const QString &urn)
+{
+    if (!m_urnLookupPending || url != QUrl::fromLocalFile(documentName)) {
+        return;
+    }
+    m_urnLookupPending = false;
+    documentUrn = urn;
+
+    if (m_waitingForIndexing) {
+        if (documentUrn.isEmpty()) {
+            QTimer::singleShot(m_indexingTries * WaitTimeOut, this, SLOT(waitForTrackerIndexing()));
+            return;
+        }
+        m_waitingForIndexing = false;
+        m_indexingTries = 0;
+        createFinalContent();
+        return;
+    }
+
+    if (!documentUrn.isEmpty()) {
+        startDocumentTracking();
+    }
+
+    if (m_viewerTypePending) {
+        m_viewerTypePending = false;
+        updateViewerType();
+    }
+}
+
+void DocumentPage::startDocumentTracking()
+{
+    TrackerUtils::Instance().updateContentAccessedProperty(documentUrn);
+    if (!liveDocument) {
+        liveDocument = TrackerUtils::Instance().createDocumentLiveUpdate(QUrl(documentName));
+        if (liveDocument) {
+            connect(liveDocument->model(), SIGNAL(dataChanged(QModelIndex,QModelIndex)), SLOT(documentsChanged(QModelIndex, QModelIndex)));
+            connect(liveDocument->model(), SIGNAL(rowsRemoved (QModelIndex, int, int)), SIGNAL(documentCloseEvent()));
+        }
+    }
+
+    if (appMenuMFAction && appMenuUFAction) {
+        changeMenus();
+    }
+}
+
 DocumentPage::~DocumentPage()
 {
     qDebug() << __PRETTY_FUNCTION__;
@@ -215,6 +304,11 @@ void DocumentPage::updateViewerType()
 {
     // set the background so that it is also correct while zooming out pdf documents
     m_pageView->setZoomBackground(true);
+    if (m_urnLookupPending) {
+        // Decided in documentUrnResolved once tracker has answered
+        m_viewerTypePending = true;
+        return;
+    }
     if (documentUrn.isEmpty()) {
         ///FIXME: Hack to prevent quickviewer from opening when the file is not yet indexed by tracker
         if (documentName.contains("/home/user/MyDocs/", Qt::CaseInsensitive) && !documentName.contains("/home/user/MyDocs/Downloads", Qt::CaseInsensitive)) {
@@ -222,11 +316,13 @@ void DocumentPage::updateViewerType()
             return;
         }
         quickViewToolbar = new QuickViewerToolbar(this);
+        connect(this, SIGNAL(sceneOrientationChanged(const M::Orientation &)),
+                quickViewToolbar, SLOT(updatePosition(const M::Orientation &)));
         quickViewer = true;
         removeActions();
+        m_deferredContentCreated = false;
         //We don't want to go to All pages view. So disconnect the connection with all pages view action
-        disconnect(ActionPool::instance()->getAction(ActionPool::ShowAllPagesView), SIGNAL(triggered()),
-                   this, SIGNAL(showAllPagesView()));
+        ActionPool::instance()->disconnectAction(ActionPool::ShowAllPagesView, this, SIGNAL(showAllPagesView()));
 
         QTimer::singleShot(0, this, SLOT(sendVisibleAreayChanged()));
     }
@@ -240,32 +336,33 @@ void DocumentPage::sendVisibleAreayChanged()
 
 void DocumentPage::waitForTrackerIndexing()
 {
-    static int tries = 1;
-
-    if (tries > 3)
-        return;
-
-    documentUrn = TrackerUtils::Instance().urnFromUrl(QUrl::fromLocalFile(documentName));
-    if (documentUrn.isEmpty()) {
-        QTimer::singleShot(tries*WaitTimeOut, this, SLOT(waitForTrackerIndexing()));
+    if (m_indexingTries >= 3) {
+        m_waitingForIndexing = false;
         return;
     }
 
-    createFinalContent();
+    ++m_indexingTries;
+    m_waitingForIndexing = true;
+    requestDocumentUrn();
 }
 
 void DocumentPage::initUI()
 {
-    applicationWindow()->setStyleName("ViewerToolbar");
-    applicationWindow()->setNavigationBarOpacity(0.8);
+    styleApplicationWindow();
 
-    connect(MApplication::activeWindow(), SIGNAL(orientationChanged(const M::Orientation &)),
+    connect(this, SIGNAL(sceneOrientationChanged(const M::Orientation &)),
             this, SLOT(changeOrientation(const M::Orientation &)));
 
     addActions();
     connectActions();
 }
 
+void DocumentPage::styleApplicationWindow()
+{
+    applicationWindow()->setStyleName("ViewerToolbar");
+    applicationWindow()->setNavigationBarOpacity(0.8);
+}
+
 void DocumentPage::closeEvent(QCloseEvent *event)
 {
     emit documentCloseEvent();
@@ -290,23 +387,6 @@ void DocumentPage::addActions()
 
     unsigned int numberOfActions = (sizeof(actionIds) / sizeof actionIds[0]);
 
-    QFileInfo fileInfo(documentName);
-    if (ApplicationWindow::DOCUMENT_SPREADSHEET != ApplicationWindow::checkMimeType(fileInfo.filePath())) {
-        // according to the spec zoom level combo should not be shown for spreadsheets
-        createCombo(ActionPool::instance()->getAction(ActionPool::Zoomlevels), ActionPool::instance()->getAction(ActionPool::ZoomFitToWidth),
-                ActionPool::instance()->getAction(ActionPool::ZoomFitToPage), ActionPool::instance()->getAction(ActionPool::Zoom100percent));
-        connect(this, SIGNAL(updateZoomLevel(ActionPool::Id)), this, SLOT(updateZoomCombobox(ActionPool::Id)));
-
-        if(zoomCombobox) {
-            zoomCombobox->setCurrentIndex(0);
-         }
-    } else {
-        createIndicatorCombo(ActionPool::instance()->getAction(ActionPool::Indicators),
-                             ActionPool::instance()->getAction(ActionPool::SpreadSheetFixedIndicators),
-                             ActionPool::instance()->getAction(ActionPool::SpreadSheetFloatingIndicators),
-                             ActionPool::instance()->getAction(ActionPool::SpreadSheetNoIndicators));
-    }
-
     for(unsigned int i = 0; i < numberOfActions; i++) {
         MAction *action = actions->getAction(actionIds[i]);
         Q_CHECK_PTR(action);
@@ -322,6 +402,45 @@ void DocumentPage::addActions()
     changeMenus();
 }
 
+void DocumentPage::scheduleDeferredContent()
+{
+    // The menu is not needed for the first page, so it waits until that
+    // has been painted
+    QTimer::singleShot(DeferredContentDelay, this, SLOT(createDeferredContent()));
+}
+
+void DocumentPage::createDeferredContent()
+{
+    if (m_deferredContentCreated || quickViewer) {
+        return;
+    }
+    m_deferredContentCreated = true;
+
+    ActionPool *actions = ActionPool::instance();
+
+    if (ApplicationWindow::DOCUMENT_SPREADSHEET != MimeTypeRegistry::viewerType(mimeType)) {
+        // according to the spec zoom level combo should not be shown for spreadsheets
+        if (!zoomCombobox) {
+            createCombo(actions->getAction(ActionPool::Zoomlevels), actions->getAction(ActionPool::ZoomFitToWidth),
+                        actions->getAction(ActionPool::ZoomFitToPage), actions->getAction(ActionPool::Zoom100percent));
+        } else {
+            insertAction(this->actions().value(0), zoomAction);
+        }
+        updateZoomCombobox(m_zoomComboItem);
+    } else {
+        if (!indicatorCombobox) {
+            createIndicatorCombo(actions->getAction(ActionPool::Indicators),
+                                 actions->getAction(ActionPool::SpreadSheetFixedIndicators),
+                                 actions->getAction(ActionPool::SpreadSheetFloatingIndicators),
+                                 actions->getAction(ActionPool::SpreadSheetNoIndicators));
+        } else {
+            insertAction(this->actions().value(0), indicatorAction);
+        }
+    }
+
+    addPluginActions();
+}
+
 void DocumentPage::changeOrientation(const M::Orientation & orientation)
 {
     switch(orientation) {
@@ -348,9 +467,9 @@ void DocumentPage::fakeDocumentSaved()
     pageIndicator->setFileName(fileTitle);
 
     addActions();
+    createDeferredContent();
     //This action was disconnected in Quick Viewer mode.
-    connect(ActionPool::instance()->getAction(ActionPool::ShowAllPagesView), SIGNAL(triggered()),
-               this, SIGNAL(showAllPagesView()));
+    ActionPool::instance()->connectAction(ActionPool::ShowAllPagesView, this, SIGNAL(showAllPagesView()), this);
 }
 
 void DocumentPage::connectActions(bool onlyToolbar)
@@ -390,9 +509,9 @@ void DocumentPage::connectActions(bool onlyToolbar)
         Q_CHECK_PTR(action);
 
         if(false == onlyToolbar) {
-            connect(action, SIGNAL(triggered()), actionData[i].object, actionData[i].slot);
+            actions->connectAction(actionData[i].id, actionData[i].object, actionData[i].slot, this);
         } else if(0 != (MAction::ToolBarLocation && action->location())) {
-            connect(action, SIGNAL(triggered()), actionData[i].object, actionData[i].slot);
+            actions->connectAction(actionData[i].id, actionData[i].object, actionData[i].slot, this);
         }
     }
 }
@@ -653,6 +772,17 @@ int DocumentPage::pageCount() const
     return totalPage;
 }
 
+qint64 DocumentPage::memoryUsage() const
+{
+    // Compressed office files say little about the size of their shapes and
+    // layout, which grow with the pages or sheets loaded
+    return QFileInfo(documentName).size() + pageCount() * DocumentPageLayoutCost;
+}
+
+void DocumentPage::saveReadingPosition()
+{
+}
+
 void DocumentPage::showInfoBanner(const QString &message)
 {
     if (!m_infoBanner) {
@@ -814,7 +944,8 @@ void DocumentPage::createIndicatorCombo(MAction *label, MAction *one, MAction *t
     indicatorCombobox->setCurrentIndex(0);
 
     indicatorAction->setWidget(indicatorCombobox);
-    addAction(indicatorAction);
+    // The combo box comes first in the menu
+    insertAction(actions().value(0), indicatorAction);
 
 }
 
@@ -865,7 +996,8 @@ void DocumentPage::createCombo(MAction *label, MAction *one, MAction *two, MActi
     zoomCombobox->setCurrentIndex(0);
 
     zoomAction->setWidget(zoomCombobox);
-    addAction(zoomAction);
+    // The combo box comes first in the menu
+    insertAction(actions().value(0), zoomAction);
 }
 
 void DocumentPage::zoomButtonClicked(int buttonId)
@@ -920,13 +1052,18 @@ void DocumentPage::updateZoomCombobox(ActionPool::Id item)
         break;
 
     case ActionPool::ZoomLastUserDefined:
-        index = zoomCombobox->currentIndex();
+        index = zoomCombobox ? zoomCombobox->currentIndex() : 0;
         break;
 
     default:
         return;
     }
 
+    m_zoomComboItem = item;
+    if (!zoomCombobox) {
+        return;
+    }
+
     QString text = ActionPool::instance()->getAction(item)->text();
     qDebug() << __PRETTY_FUNCTION__ << text;
 
@@ -993,13 +1130,9 @@ void DocumentPage::documentsChanged(QModelIndex topLeft, QModelIndex bottomRight
     Q_UNUSED(bottomRight);
     qDebug() << __PRETTY_FUNCTION__;
 
-    if(topLeft.sibling(topLeft.row(), 1).data().toString().isNull()) {
-        appMenuMFAction->setVisible(true);
-        appMenuUFAction->setVisible(false);
-    } else {
-        appMenuMFAction->setVisible(false);
-        appMenuUFAction->setVisible(true);
-    }
+    bool favorite = !topLeft.sibling(topLeft.row(), 1).data().toString().isNull();
+    TrackerUtils::Instance().cacheFavoriteStatus(documentUrn, favorite);
+    setFavoriteMenus(favorite);
 
     if (0 == liveDocument->model()->rowCount()) {
         qWarning() << "Document was deleted......";
@@ -1009,15 +1142,29 @@ void DocumentPage::documentsChanged(QModelIndex topLeft, QModelIndex bottomRight
 
 void DocumentPage::changeMenus()
 {
-    if(DocumentListModel::documentIsFavorite(getDocumentUrn(documentName))) {
-        appMenuMFAction->setVisible(false);
-        appMenuUFAction->setVisible(true);
-    } else {
-        appMenuMFAction->setVisible(true);
-        appMenuUFAction->setVisible(false);
+    setFavoriteMenus(false);
+
+    if(!documentUrn.isEmpty()) {
+        TrackerUtils &tracker = TrackerUtils::Instance();
+        connect(&tracker, SIGNAL(favoriteStatusReady(QString, bool)),
+                this, SLOT(favoriteStatusResolved(QString, bool)), Qt::UniqueConnection);
+        tracker.requestFavoriteStatus(documentUrn);
     }
 }
 
+void DocumentPage::favoriteStatusResolved(const QString &urn, bool favorite)
+{
+    if(urn == documentUrn) {
+        setFavoriteMenus(favorite);
+    }
+}
+
+void DocumentPage::setFavoriteMenus(bool favorite)
+{
+    appMenuMFAction->setVisible(!favorite);
+    appMenuUFAction->setVisible(favorite);
+}
+
 void DocumentPage::slotJumpToPage()
 {
     if (!jumpToPageOverlay) {
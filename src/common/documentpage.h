@@ -26,14 +26,17 @@
 #include <QTimer>
 #include <QList>
 #include <QModelIndex>
+#include <QPointer>
 
 #include <MAction>
 #include <MApplicationPage>
+#include <MSceneManager>
 
 #include "zoomlevel.h"
 #include "actionpool.h"
 
 class QStringListModel;
+class QUrl;
 class QGraphicsSceneMouseEvent;
 class QPropertyAnimation;
 class TrackerLiveQuery;
@@ -137,6 +140,18 @@ signals:
      * \brief Signal emited when normal view has to be shown
      */
     void showNormalView();
+
+    /*!
+     * \brief Relays orientationChanged of the scene manager of the window
+     * showing the page, also when the page moves to another window
+     */
+    void sceneOrientationChanged(const M::Orientation &orientation);
+
+    /*!
+     * \brief Relays orientationChangeFinished of the scene manager of the
+     * window showing the page
+     */
+    void sceneOrientationChangeFinished(const M::Orientation &orientation);
     /*!
      * \brief Signal emited when zoom level is changed by double tap
      */
@@ -152,6 +167,7 @@ signals:
 
 protected:
 
+    virtual QVariant itemChange(GraphicsItemChange change, const QVariant &value);
     virtual void keyReleaseEvent(QKeyEvent *event);
     virtual void pinchGestureEvent(QGestureEvent *event, QPinchGesture *gesture);
     virtual void tapAndHoldGestureEvent(QGestureEvent *event, QTapAndHoldGesture *gesture);
@@ -162,6 +178,8 @@ public:
 
     //! Document name which can be sent to Share UI
     QString documentName;
+    //! Mime type detected when the document was opened
+    QString mimeType;
     //! Document urn as given by tracker.
     QString documentUrn;
     //File Title
@@ -213,8 +231,28 @@ public:
 
     void setDocumentName(const QString &name) { documentName = name; }
 
+    void setMimeType(const QString &type) { mimeType = type; }
+
     int pageCount() const;
 
+    /*!
+     * \brief Tells if the document has been loaded successfully
+     */
+    bool isDocumentLoaded() const { return pageLoaded; }
+
+    /*!
+     * \brief Estimates the memory the page uses for its document, used for
+     * the budget of #DocumentPageCache
+     * \return The estimate in bytes
+     */
+    virtual qint64 memoryUsage() const;
+
+    /*!
+     * \brief Stores where the document was read, so that it can be opened
+     * there again. Called when the document is closed.
+     */
+    virtual void saveReadingPosition();
+
 public slots:
 
     /*!
@@ -306,6 +344,12 @@ protected:
     virtual void pinchFinished(const QPointF &center, qreal scale) = 0;
     virtual QGraphicsWidget *pinchWidget() = 0;
 
+    /*!
+     * \brief Adds the menu actions of the extension plugins, called with
+     * the other deferred menu content
+     */
+    virtual void addPluginActions() {}
+
 protected slots:
 
     /*!
@@ -363,6 +407,13 @@ protected slots:
      */
     void restoreZoomLevelText();
 
+    /*!
+     * \brief Builds the menu content which is not needed for the first page:
+     * the zoom or indicator combo box and the plugin actions. Called once in
+     * idle time after the document has loaded.
+     */
+    void createDeferredContent();
+
 private slots:
     void showInfoBanner(const QString &message);
     void shortTapEvent();
@@ -379,6 +430,17 @@ private slots:
     void setupBounceAnimation();
     void bounceAnimationFinished();
     void updateViewerType();
+    void scheduleDeferredContent();
+
+    /*!
+     * \brief Receives the answer of the asynchronous urn lookup started for the document
+     */
+    void documentUrnResolved(const QUrl &url, const QString &urn);
+
+    /*!
+     * \brief Updates the favorite menu items when the favorite status is known
+     */
+    void favoriteStatusResolved(const QString &urn, bool favorite);
 
 private:
     // finish the zoom by pinching
@@ -397,6 +459,19 @@ private:
      */
     void connectActions(bool onlyToolbar=false);
 
+    /*!
+     * \brief Starts resolving the tracker urn of the document without blocking
+     */
+    void requestDocumentUrn();
+
+    /*!
+     * \brief Updates access time and starts following the tracker data of the document.
+     * Called once the urn is known.
+     */
+    void startDocumentTracking();
+
+    void setFavoriteMenus(bool favorite);
+
     bool searchActive() const;
 
     void hideFindToolbar();
@@ -426,6 +501,11 @@ private:
      */
     void removeMainViewActions();
 
+    /*!
+     * \brief Sets the look of the window the page is shown in
+     */
+    void styleApplicationWindow();
+
 
 protected:
     bool m_pinchInProgress;
@@ -471,6 +551,18 @@ private:
     bool                quickViewer;
     ZoomBackground     *m_pageView;
     qreal               m_lastZoomFactor;
+    //! True while the urn of the document is being resolved
+    bool                m_urnLookupPending;
+    //! True if updateViewerType has to wait for the urn lookup
+    bool                m_viewerTypePending;
+    bool                m_waitingForIndexing;
+    //! Urn lookups done while waiting for tracker to index the document
+    int                 m_indexingTries;
+    //! Zoom level to show once the zoom combo box is created
+    ActionPool::Id      m_zoomComboItem;
+    bool                m_deferredContentCreated;
+    //! Scene manager of the window the page is in
+    QPointer<MSceneManager> m_sceneManager;
 };
 
 #endif // DOCUMENTPAGE_H
@@ -0,0 +1,121 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QFileInfo>
+#include <QGraphicsScene>
+
+#include <MSceneManager>
+
+#include "documentpagecache.h"
+#include "documentpage.h"
+#include "definitions.h"
+#include "actionpool.h"
+
+DocumentPageCache &DocumentPageCache::instance()
+{
+    static DocumentPageCache cache;
+    return cache;
+}
+
+DocumentPageCache::DocumentPageCache()
+{
+}
+
+DocumentPageCache::~DocumentPageCache()
+{
+    clear();
+}
+
+void DocumentPageCache::insert(DocumentPage *page)
+{
+    if (!page) {
+        return;
+    }
+
+    if (!page->isDocumentLoaded()) {
+        delete page;
+        return;
+    }
+
+    // The window the page was shown in may go away, and its scene with it
+    if (page->sceneManager()) {
+        page->sceneManager()->disappearSceneWindowNow(page);
+    }
+    if (page->scene()) {
+        page->scene()->removeItem(page);
+    }
+
+    // Hidden pages must not follow the shared actions, which only skip
+    // pages shown in another window
+    ActionPool::instance()->setScopeEnabled(page, false);
+
+    Entry entry;
+    entry.page = page;
+    entry.modified = QFileInfo(page->documentName).lastModified();
+    entries.prepend(entry);
+
+    trim();
+}
+
+DocumentPage *DocumentPageCache::take(const QString &path)
+{
+    for (int i = 0; i < entries.size(); ++i) {
+        if (entries.at(i).page->documentName == path) {
+            Entry entry = entries.takeAt(i);
+            ActionPool::instance()->setScopeEnabled(entry.page, true);
+            const QFileInfo fileInfo(path);
+            if (fileInfo.exists() && fileInfo.lastModified() == entry.modified) {
+                return entry.page;
+            }
+            delete entry.page;
+            return 0;
+        }
+    }
+    return 0;
+}
+
+void DocumentPageCache::clear()
+{
+    while (!entries.isEmpty()) {
+        DocumentPage *page = entries.takeLast().page;
+        ActionPool::instance()->setScopeEnabled(page, true);
+        delete page;
+    }
+}
+
+void DocumentPageCache::trim()
+{
+    qint64 usage = 0;
+    for (int i = 0; i < entries.size(); ++i) {
+        usage += entries.at(i).page->memoryUsage();
+    }
+
+    while (!entries.isEmpty() &&
+           (entries.size() > MaxCachedDocuments || usage > DocumentCacheBudget)) {
+        DocumentPage *page = entries.takeLast().page;
+        usage -= page->memoryUsage();
+        ActionPool::instance()->setScopeEnabled(page, true);
+        delete page;
+    }
+}
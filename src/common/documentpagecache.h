@@ -0,0 +1,85 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef DOCUMENTPAGECACHE_H
+#define DOCUMENTPAGECACHE_H
+
+#include <QList>
+#include <QDateTime>
+
+#include <common_export.h>
+
+class DocumentPage;
+
+/*!
+ * \class DocumentPageCache
+ * \brief Keeps the pages of recently closed documents
+ *
+ * A closed page keeps its parsed document and the pages it has rendered,
+ * so opening the same document again only shows the page. At most
+ * MaxCachedDocuments pages are kept, and the oldest are deleted when the
+ * pages together use more than DocumentCacheBudget bytes.
+ */
+class COMMON_EXPORT DocumentPageCache
+{
+public:
+    static DocumentPageCache &instance();
+
+    /*!
+     * \brief Takes the page of a closed document. Pages which did not load
+     * their document are deleted.
+     * \param page The page, which must not be shown any more
+     */
+    void insert(DocumentPage *page);
+
+    /*!
+     * \brief Gives the cached page of a document back
+     * \param path The local path of the document
+     * \return The page, or 0 if there is none or the file has changed
+     */
+    DocumentPage *take(const QString &path);
+
+    /*!
+     * \brief Deletes all cached pages
+     */
+    void clear();
+
+private:
+    DocumentPageCache();
+    ~DocumentPageCache();
+    Q_DISABLE_COPY(DocumentPageCache)
+
+    void trim();
+
+    struct Entry {
+        DocumentPage *page;
+        //! Modification time of the file when the page was cached
+        QDateTime modified;
+    };
+
+    //! Most recently closed first
+    QList<Entry> entries;
+};
+
+#endif // DOCUMENTPAGECACHE_H
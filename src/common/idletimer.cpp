@@ -0,0 +1,68 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <QCoreApplication>
+#include <QEvent>
+
+#include "idletimer.h"
+
+void IdleTimer::singleShot(int msec, QObject *receiver, const char *member)
+{
+    IdleTimer *timer = new IdleTimer(msec, receiver);
+    connect(timer, SIGNAL(timeout()), receiver, member);
+}
+
+IdleTimer::IdleTimer(int msec, QObject *receiver)
+    : QObject(receiver)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(msec);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(fire()));
+    m_timer.start();
+
+    QCoreApplication::instance()->installEventFilter(this);
+}
+
+bool IdleTimer::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove:
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+    case QEvent::KeyPress:
+        m_timer.start();
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void IdleTimer::fire()
+{
+    emit timeout();
+    deleteLater();
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef IDLETIMER_H
+#define IDLETIMER_H
+
+#include <QObject>
+#include <QTimer>
+
+#include <common_export.h>
+
+/*!
+ * \class IdleTimer
+ * \brief Calls a slot once the user has left the application alone
+ *
+ * Like QTimer::singleShot, but every touch, mouse or key event starts the
+ * interval again, so work which is not needed yet does not get in the way
+ * of the user.
+ */
+class COMMON_EXPORT IdleTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief Calls the member of the receiver after msec milliseconds
+     * without user input. Nothing is called if the receiver is deleted first.
+     */
+    static void singleShot(int msec, QObject *receiver, const char *member);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event);
+
+signals:
+    void timeout();
+
+private slots:
+    void fire();
+
+private:
+    IdleTimer(int msec, QObject *receiver);
+
+    QTimer m_timer;
+};
+
+#endif // IDLETIMER_H
@@ -0,0 +1,163 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <QSharedMemory>
+#include <QCryptographicHash>
+#include <QDebug>
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "instanceregistry.h"
+
+namespace
+{
+    const char RegistryKey[] = "office-tools-instance-registry";
+    const int MaxEntries = 64;
+
+    struct Entry {
+        //! 0 for a free entry
+        qint32 pid;
+        qint32 kind;
+        //! md5 of the document path
+        char pathHash[16];
+    };
+
+    bool isRunning(pid_t pid)
+    {
+        return ::kill(pid, 0) == 0 || errno == EPERM;
+    }
+
+    QByteArray pathHash(const QString &path)
+    {
+        return QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Md5);
+    }
+}
+
+class InstanceRegistry::Private
+{
+public:
+    Private()
+    : memory(RegistryKey)
+    {
+        if (!memory.attach()) {
+            // New segments are zero filled, that is all entries are free
+            if (!memory.create(MaxEntries * sizeof(Entry)) && !memory.attach()) {
+                qWarning() << __PRETTY_FUNCTION__ << memory.errorString();
+            }
+        }
+    }
+
+    Entry *entries()
+    {
+        return static_cast<Entry *>(memory.data());
+    }
+
+    //! Finds the entry, the memory must be locked
+    Entry *find(Kind kind, const QByteArray &hash, pid_t pid)
+    {
+        Entry *entry = entries();
+        for (int i = 0; i < MaxEntries; ++i, ++entry) {
+            if (entry->pid != 0 && entry->kind == kind &&
+                (pid == 0 || entry->pid == pid) &&
+                memcmp(entry->pathHash, hash.constData(), sizeof entry->pathHash) == 0) {
+                if (isRunning(entry->pid)) {
+                    return entry;
+                }
+                entry->pid = 0;
+            }
+        }
+        return 0;
+    }
+
+    QSharedMemory memory;
+};
+
+InstanceRegistry &InstanceRegistry::instance()
+{
+    static InstanceRegistry registry;
+    return registry;
+}
+
+InstanceRegistry::InstanceRegistry()
+: d(new Private())
+{
+}
+
+InstanceRegistry::~InstanceRegistry()
+{
+    delete d;
+}
+
+void InstanceRegistry::add(Kind kind, const QString &path)
+{
+    if (!d->memory.isAttached() || !d->memory.lock()) {
+        return;
+    }
+
+    const QByteArray hash = pathHash(path);
+    const pid_t pid = getpid();
+
+    if (!d->find(kind, hash, pid)) {
+        Entry *entry = d->entries();
+        for (int i = 0; i < MaxEntries; ++i, ++entry) {
+            if (entry->pid == 0 || !isRunning(entry->pid)) {
+                entry->pid = pid;
+                entry->kind = kind;
+                memcpy(entry->pathHash, hash.constData(), sizeof entry->pathHash);
+                break;
+            }
+        }
+    }
+
+    d->memory.unlock();
+}
+
+void InstanceRegistry::remove(Kind kind, const QString &path)
+{
+    if (!d->memory.isAttached() || !d->memory.lock()) {
+        return;
+    }
+
+    Entry *entry = d->find(kind, pathHash(path), getpid());
+    if (entry) {
+        entry->pid = 0;
+    }
+
+    d->memory.unlock();
+}
+
+pid_t InstanceRegistry::find(Kind kind, const QString &path)
+{
+    if (!d->memory.isAttached() || !d->memory.lock()) {
+        return 0;
+    }
+
+    Entry *entry = d->find(kind, pathHash(path), 0);
+    const pid_t pid = entry ? entry->pid : 0;
+
+    d->memory.unlock();
+    return pid;
+}
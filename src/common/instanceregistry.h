@@ -0,0 +1,81 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef INSTANCEREGISTRY_H
+#define INSTANCEREGISTRY_H
+
+#include <QString>
+#include <sys/types.h>
+
+#include <common_export.h>
+
+/*!
+ * \class InstanceRegistry
+ * \brief Tells which office-tools process shows what.
+ *
+ * The registry is a small table in shared memory, so asking it needs
+ * neither a config file sync nor looking at /proc. Entries of processes
+ * that are gone are ignored and reused.
+ */
+class COMMON_EXPORT InstanceRegistry
+{
+public:
+    enum Kind {
+        //! The process owning the office-tools D-Bus service
+        FirstInstance = 1,
+        //! The process showing the front page
+        FrontPage,
+        //! A process showing the document given as path
+        Document
+    };
+
+    static InstanceRegistry &instance();
+
+    /*!
+     * \brief Registers this process
+     * \param kind What this process shows
+     * \param path The local path of the document for #Document
+     */
+    void add(Kind kind, const QString &path = QString());
+
+    /*!
+     * \brief Removes an entry added by this process
+     */
+    void remove(Kind kind, const QString &path = QString());
+
+    /*!
+     * \brief Finds a running process
+     * \return The pid of the process, 0 if there is none
+     */
+    pid_t find(Kind kind, const QString &path = QString());
+
+private:
+    InstanceRegistry();
+    ~InstanceRegistry();
+    Q_DISABLE_COPY(InstanceRegistry)
+
+    class Private;
+    Private * const d;
+};
+
+#endif // INSTANCEREGISTRY_H
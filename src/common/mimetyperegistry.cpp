@@ -0,0 +1,181 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QHash>
+
+#include <KMimeType>
+
+#include "mimetyperegistry.h"
+#include "applicationwindow.h"
+#include "documentlistmodel.h"
+
+namespace
+{
+    struct MimeTypeEntry {
+        const char *mimeType;
+        ApplicationWindow::DocumentType viewerType;
+        const char *labelId;
+        //! Files with this suffix get alternativeLabelId instead
+        const char *alternativeSuffix;
+        const char *alternativeLabelId;
+    };
+
+    const MimeTypeEntry mimeTypes[] = {
+        { "application/msword", ApplicationWindow::DOCUMENT_WORD, "qtn_comm_filetype_doc", 0, 0 },
+        { "application/x-mswrite", ApplicationWindow::DOCUMENT_WORD, "qtn_comm_filetype_doc", 0, 0 },
+        { "text/plain", ApplicationWindow::DOCUMENT_WORD, "qtn_comm_filetype_txt", 0, 0 },
+        { "application/vnd.oasis.opendocument.text", ApplicationWindow::DOCUMENT_WORD, "qtn_comm_filetype_odt", 0, 0 },
+        { "application/vnd.openxmlformats-officedocument.wordprocessingml.document", ApplicationWindow::DOCUMENT_WORD, "qtn_comm_filetype_docx", 0, 0 },
+        { "application/rtf", ApplicationWindow::DOCUMENT_WORD, "qtn_comm_filetype_rtf", 0, 0 },
+        { "application/x-vnd.oasis.opendocument.text", ApplicationWindow::DOCUMENT_WORD, 0, 0, 0 },
+        { "application/vnd.ms-word.document.macroEnabled.12", ApplicationWindow::DOCUMENT_WORD, 0, 0, 0 },
+        { "application/vnd.openxmlformats-officedocument.wordprocessingml.template", ApplicationWindow::DOCUMENT_WORD, 0, 0, 0 },
+        { "application/vnd.ms-word.template.macroEnabled.12", ApplicationWindow::DOCUMENT_WORD, 0, 0, 0 },
+        { "application/vnd.oasis.opendocument.text-template", ApplicationWindow::DOCUMENT_WORD, 0, 0, 0 },
+        { "application/x-vnd.oasis.opendocument.text-template", ApplicationWindow::DOCUMENT_WORD, 0, 0, 0 },
+
+        { "application/pdf", ApplicationWindow::DOCUMENT_PDF, "qtn_comm_filetype_pdf", 0, 0 },
+
+        { "application/mspowerpoint", ApplicationWindow::DOCUMENT_PRESENTATION, "qtn_comm_filetype_ppt", "pps", "qtn_comm_filetype_pps" },
+        { "application/vnd.ms-powerpoint", ApplicationWindow::DOCUMENT_PRESENTATION, "qtn_comm_filetype_ppt", "pps", "qtn_comm_filetype_pps" },
+        { "application/vnd.ms-powerpoint.slideshow.macroEnabled.12", ApplicationWindow::DOCUMENT_PRESENTATION, "qtn_comm_filetype_pps", 0, 0 },
+        { "application/vnd.oasis.opendocument.presentation", ApplicationWindow::DOCUMENT_PRESENTATION, "qtn_comm_filetype_odp", 0, 0 },
+        { "application/vnd.oasis.opendocument.presentation-template", ApplicationWindow::DOCUMENT_PRESENTATION, "qtn_comm_filetype_odp", 0, 0 },
+        { "application/x-vnd.oasis.opendocument.presentation-template", ApplicationWindow::DOCUMENT_PRESENTATION, 0, 0, 0 },
+        { "application/vnd.openxmlformats-officedocument.presentationml.presentation", ApplicationWindow::DOCUMENT_PRESENTATION, "qtn_comm_filetype_pptx", 0, 0 },
+        { "application/vnd.openxmlformats-officedocument.presentationml.slideshow", ApplicationWindow::DOCUMENT_PRESENTATION, "qtn_comm_filetype_ppsx", 0, 0 },
+        { "application/x-vnd.oasis.opendocument.presentation", ApplicationWindow::DOCUMENT_PRESENTATION, 0, 0, 0 },
+        { "application/vnd.ms-powerpoint.presentation.macroEnabled.12", ApplicationWindow::DOCUMENT_PRESENTATION, 0, 0, 0 },
+        { "application/vnd.ms-powerpoint.addin.macroEnabled.12", ApplicationWindow::DOCUMENT_PRESENTATION, 0, 0, 0 },
+        { "application/vnd.openxmlformats-officedocument.presentationml.template", ApplicationWindow::DOCUMENT_PRESENTATION, 0, 0, 0 },
+
+        { "application/vnd.ms-excel", ApplicationWindow::DOCUMENT_SPREADSHEET, "qtn_comm_filetype_xls", 0, 0 },
+        { "application/vnd.oasis.opendocument.spreadsheet", ApplicationWindow::DOCUMENT_SPREADSHEET, "qtn_comm_filetype_ods", 0, 0 },
+        { "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet", ApplicationWindow::DOCUMENT_SPREADSHEET, "qtn_comm_filetype_xlsx", 0, 0 },
+        { "application/x-vnd.oasis.opendocument.spreadsheet", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/excel", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/vnd.ms-excel.sheet.macroEnabled.12", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/vnd.ms-excel.sheet.binary.macroEnabled.12", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/vnd.oasis.opendocument.spreadsheet-template", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/x-vnd.oasis.opendocument.spreadsheet-template", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/vnd.openxmlformats-officedocument.spreadsheetml.template", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/vnd.ms-excel.template.macroEnabled.12", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/x-excel", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/xlt", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/x-msexcel", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 },
+        { "application/msexcel", ApplicationWindow::DOCUMENT_SPREADSHEET, 0, 0, 0 }
+    };
+
+    struct LabelEntry {
+        const char *labelId;
+        DocumentListModel::DocumentCategory category;
+    };
+
+    const LabelEntry labels[] = {
+        { "qtn_comm_filetype_doc",  DocumentListModel::DOCUMENT },
+        { "qtn_comm_filetype_rtf",  DocumentListModel::DOCUMENT },
+        { "qtn_comm_filetype_docx", DocumentListModel::DOCUMENT },
+        { "qtn_comm_filetype_odt",  DocumentListModel::OPEN_DOC_TEXT },
+        { "qtn_comm_filetype_txt",  DocumentListModel::TEXT },
+        { "qtn_comm_filetype_pdf",  DocumentListModel::PDF },
+        { "qtn_comm_filetype_ppt",  DocumentListModel::PRESENTATION },
+        { "qtn_comm_filetype_pps",  DocumentListModel::PRESENTATION },
+        { "qtn_comm_filetype_pptx", DocumentListModel::PRESENTATION },
+        { "qtn_comm_filetype_ppsx", DocumentListModel::PRESENTATION },
+        { "qtn_comm_filetype_odp",  DocumentListModel::OPEN_DOC_PPT },
+        { "qtn_comm_filetype_xls",  DocumentListModel::SPREADSHEET },
+        { "qtn_comm_filetype_xlsx", DocumentListModel::SPREADSHEET },
+        { "qtn_comm_filetype_ods",  DocumentListModel::OPEN_DOC_XLS }
+    };
+
+    struct MimeTypeInfo {
+        int viewerType;
+        int category;
+        QString labelId;
+        QString alternativeSuffix;
+        QString alternativeLabelId;
+    };
+
+    struct Registry {
+        Registry()
+        {
+            for (unsigned int i = 0; i < sizeof(labels) / sizeof labels[0]; ++i) {
+                categories.insert(labels[i].labelId, labels[i].category);
+            }
+
+            for (unsigned int i = 0; i < sizeof(mimeTypes) / sizeof mimeTypes[0]; ++i) {
+                MimeTypeInfo info;
+                info.viewerType = mimeTypes[i].viewerType;
+                info.labelId = mimeTypes[i].labelId;
+                info.category = categories.value(info.labelId, DocumentListModel::UNKNOWNTYPE);
+                info.alternativeSuffix = mimeTypes[i].alternativeSuffix;
+                info.alternativeLabelId = mimeTypes[i].alternativeLabelId;
+                infos.insert(mimeTypes[i].mimeType, info);
+            }
+        }
+
+        QHash<QString, MimeTypeInfo> infos;
+        QHash<QString, int> categories;
+    };
+
+    const Registry &registry()
+    {
+        static const Registry instance;
+        return instance;
+    }
+}
+
+QString MimeTypeRegistry::mimeTypeForPath(const QString &path)
+{
+    return KMimeType::findByPath(path)->name();
+}
+
+int MimeTypeRegistry::viewerType(const QString &mimeType)
+{
+    QHash<QString, MimeTypeInfo>::const_iterator i = registry().infos.constFind(mimeType);
+    return i == registry().infos.constEnd() ? ApplicationWindow::DOCUMENT_UNKOWN : i->viewerType;
+}
+
+int MimeTypeRegistry::category(const QString &mimeType)
+{
+    QHash<QString, MimeTypeInfo>::const_iterator i = registry().infos.constFind(mimeType);
+    return i == registry().infos.constEnd() ? DocumentListModel::UNKNOWNTYPE : i->category;
+}
+
+QString MimeTypeRegistry::labelId(const QString &mimeType, const QString &extension)
+{
+    QHash<QString, MimeTypeInfo>::const_iterator i = registry().infos.constFind(mimeType);
+    if (i == registry().infos.constEnd()) {
+        return QString();
+    }
+    if (!i->alternativeSuffix.isEmpty() && i->alternativeSuffix == extension) {
+        return i->alternativeLabelId;
+    }
+    return i->labelId;
+}
+
+int MimeTypeRegistry::categoryForLabel(const QString &labelId)
+{
+    return registry().categories.value(labelId, DocumentListModel::UNKNOWNTYPE);
+}
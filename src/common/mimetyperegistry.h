@@ -0,0 +1,76 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef MIMETYPEREGISTRY_H
+#define MIMETYPEREGISTRY_H
+
+#include <QString>
+
+#include <common_export.h>
+
+/*!
+ * \brief The supported mime types and what is known about them.
+ *
+ * All lookups are a single hash probe into a table built once. Detecting
+ * the mime type of a file is expensive, so it is done once when the
+ * document is opened and the result is passed on.
+ */
+namespace MimeTypeRegistry
+{
+/*!
+ * \brief Detects the mime type of a file.
+ * \param path is the path of the file
+ * \returns the name of the mime type
+ */
+COMMON_EXPORT QString mimeTypeForPath(const QString &path);
+
+/*!
+ * \brief Gives the viewer for a mime type.
+ * \returns an ApplicationWindow::DocumentType, DOCUMENT_UNKOWN if the type can not be viewed
+ */
+COMMON_EXPORT int viewerType(const QString &mimeType);
+
+/*!
+ * \brief Gives the document list category of a mime type.
+ * \returns a DocumentListModel::DocumentCategory, UNKNOWNTYPE if the list has no label for the type
+ */
+COMMON_EXPORT int category(const QString &mimeType);
+
+/*!
+ * \brief Gives the logical id of the file type label.
+ * \param mimeType is the name of the mime type
+ * \param extension is the file suffix, needed to tell slide shows from presentations
+ * \returns a qtn_comm_filetype_* id, empty if the list has no label for the type
+ */
+COMMON_EXPORT QString labelId(const QString &mimeType, const QString &extension = QString());
+
+/*!
+ * \brief Gives the document list category for a file type label.
+ * \param labelId is a qtn_comm_filetype_* id
+ * \returns a DocumentListModel::DocumentCategory
+ */
+COMMON_EXPORT int categoryForLabel(const QString &labelId);
+};
+
+#endif // MIMETYPEREGISTRY_H
@@ -28,10 +28,10 @@
 #include <MLayout>
 #include <MFlowLayoutPolicy>
 #include <MPannableViewport>
-#include <KMimeType>
 
 #include "applicationwindow.h"
 #include "misc.h"
+#include "mimetyperegistry.h"
 
 QPointF Misc::getRelativePoint(const QPointF &point, const QSizeF &size)
 {
@@ -130,60 +130,10 @@ MWidget * Misc::createHorizontalWidget(MWidget * child)
 
 QString Misc::getFileTypeFromFile(QString filePath)
 {
-    return qtTrId(getFileTypeFromMime(KMimeType::findByPath(filePath)->name()).toLatin1().data());
+    return qtTrId(MimeTypeRegistry::labelId(MimeTypeRegistry::mimeTypeForPath(filePath)).toLatin1().data());
 }
 
 QString Misc::getFileTypeFromMime(QString mimeType, QString extension)
 {
-    if((QString::compare("application/msword", mimeType) == 0) ||
-       (QString::compare("application/x-mswrite", mimeType) == 0))
-        return "qtn_comm_filetype_doc";
-
-    if(QString::compare("text/plain", mimeType) == 0)
-        return "qtn_comm_filetype_txt";
-
-    if(QString::compare("application/pdf", mimeType) == 0)
-        return "qtn_comm_filetype_pdf";
-
-    if((QString::compare("application/mspowerpoint", mimeType) == 0) ||
-       (QString::compare("application/vnd.ms-powerpoint", mimeType) == 0)) {
-        if (0 == QString::compare("pps", extension)) {
-            return "qtn_comm_filetype_pps";
-        } else {
-            return "qtn_comm_filetype_ppt";
-        }
-    }
-
-    if(QString::compare("application/vnd.ms-powerpoint.slideshow.macroEnabled.12", mimeType) == 0)
-        return "qtn_comm_filetype_pps";
-
-    if(QString::compare("application/vnd.ms-excel", mimeType) == 0)
-        return "qtn_comm_filetype_xls";
-
-    if(QString::compare("application/vnd.oasis.opendocument.text", mimeType) == 0)
-        return "qtn_comm_filetype_odt";
-
-    if((QString::compare("application/vnd.oasis.opendocument.presentation", mimeType) == 0) ||
-       (QString::compare("application/vnd.oasis.opendocument.presentation-template", mimeType) == 0))
-        return "qtn_comm_filetype_odp";
-
-    if(QString::compare("application/vnd.oasis.opendocument.spreadsheet", mimeType) == 0)
-        return "qtn_comm_filetype_ods";
-
-    if(QString::compare("application/vnd.openxmlformats-officedocument.wordprocessingml.document", mimeType) == 0)
-        return "qtn_comm_filetype_docx";
-
-    if(QString::compare("application/vnd.openxmlformats-officedocument.presentationml.presentation", mimeType) == 0)
-        return "qtn_comm_filetype_pptx";
-
-    if(QString::compare("application/vnd.openxmlformats-officedocument.presentationml.slideshow", mimeType) == 0)
-        return "qtn_comm_filetype_ppsx";
-
-    if(QString::compare("application/vnd.openxmlformats-officedocument.spreadsheetml.sheet", mimeType) == 0)
-        return "qtn_comm_filetype_xlsx";
-
-    if(QString::compare("application/rtf", mimeType) == 0)
-        return "qtn_comm_filetype_rtf";
-
-    return QString();
+    return MimeTypeRegistry::labelId(mimeType, extension);
 }
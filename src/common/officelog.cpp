@@ -0,0 +1,67 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QStringList>
+
+#include "officelog.h"
+
+namespace
+{
+    struct CategoryName {
+        const char *name;
+        OfficeLog::Category category;
+    };
+
+    const CategoryName categoryNames[] = {
+        { "paint", OfficeLog::Paint },
+        { "cache", OfficeLog::Cache },
+        { "render", OfficeLog::Render },
+        { "scroll", OfficeLog::Scroll },
+        { "thumbnail", OfficeLog::Thumbnail }
+    };
+
+    int enabledCategories()
+    {
+        int categories = 0;
+        const QStringList names = QString::fromLocal8Bit(qgetenv("OFFICE_TOOLS_LOG")).toLower().split(',', QString::SkipEmptyParts);
+        foreach(const QString &name, names) {
+            const QString trimmed = name.trimmed();
+            if (trimmed == "all") {
+                categories = ~0;
+            }
+            for (unsigned int i = 0; i < sizeof(categoryNames) / sizeof categoryNames[0]; ++i) {
+                if (trimmed == categoryNames[i].name) {
+                    categories |= categoryNames[i].category;
+                }
+            }
+        }
+        return categories;
+    }
+}
+
+bool OfficeLog::isEnabled(Category category)
+{
+    static const int categories = enabledCategories();
+    return categories & category;
+}
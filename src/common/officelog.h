@@ -0,0 +1,108 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef OFFICELOG_H
+#define OFFICELOG_H
+
+#include <QDebug>
+
+#include <common_export.h>
+
+/*!
+ * \brief Logging for code that runs on every frame
+ *
+ * OFFICE_LOG(Category) is used like qDebug(). The arguments are only
+ * evaluated when the category is on, so an off category costs no string
+ * formatting.
+ *
+ * In release builds a category is only compiled in when it is defined at
+ * build time, e.g. DEFINES += OFFICE_LOG_PAINT, or OFFICE_LOG_ALL for all of
+ * them. Debug builds contain all categories and turn them on at runtime
+ * from OFFICE_TOOLS_LOG, a comma separated list like "paint,scroll" or
+ * "all".
+ */
+namespace OfficeLog
+{
+    enum Category {
+        //! Painting of document pages
+        Paint     = 0x01,
+        //! The page image cache
+        Cache     = 0x02,
+        //! Rendering of pages in the loader thread
+        Render    = 0x04,
+        //! Panning and scrolling
+        Scroll    = 0x08,
+        //! Thumbnails
+        Thumbnail = 0x10
+    };
+
+    /*!
+     * \brief Checks whether a category is turned on in OFFICE_TOOLS_LOG
+     */
+    COMMON_EXPORT bool isEnabled(Category category);
+}
+
+#if defined(OFFICE_LOG_ALL) || defined(OFFICE_LOG_PAINT)
+#define OFFICE_LOG_BUILT_PAINT OfficeLog::Paint
+#else
+#define OFFICE_LOG_BUILT_PAINT 0
+#endif
+
+#if defined(OFFICE_LOG_ALL) || defined(OFFICE_LOG_CACHE)
+#define OFFICE_LOG_BUILT_CACHE OfficeLog::Cache
+#else
+#define OFFICE_LOG_BUILT_CACHE 0
+#endif
+
+#if defined(OFFICE_LOG_ALL) || defined(OFFICE_LOG_RENDER)
+#define OFFICE_LOG_BUILT_RENDER OfficeLog::Render
+#else
+#define OFFICE_LOG_BUILT_RENDER 0
+#endif
+
+#if defined(OFFICE_LOG_ALL) || defined(OFFICE_LOG_SCROLL)
+#define OFFICE_LOG_BUILT_SCROLL OfficeLog::Scroll
+#else
+#define OFFICE_LOG_BUILT_SCROLL 0
+#endif
+
+#if defined(OFFICE_LOG_ALL) || defined(OFFICE_LOG_THUMBNAIL)
+#define OFFICE_LOG_BUILT_THUMBNAIL OfficeLog::Thumbnail
+#else
+#define OFFICE_LOG_BUILT_THUMBNAIL 0
+#endif
+
+//! Categories compiled into a release build
+const int OfficeLogBuilt = OFFICE_LOG_BUILT_PAINT | OFFICE_LOG_BUILT_CACHE | OFFICE_LOG_BUILT_RENDER
+                           | OFFICE_LOG_BUILT_SCROLL | OFFICE_LOG_BUILT_THUMBNAIL;
+
+#ifdef QT_NO_DEBUG
+#define OFFICE_LOG(category) \
+    if (!(OfficeLogBuilt & OfficeLog::category)) {} else qDebug()
+#else
+#define OFFICE_LOG(category) \
+    if (!OfficeLog::isEnabled(OfficeLog::category)) {} else qDebug()
+#endif
+
+#endif // OFFICELOG_H
@@ -30,6 +30,7 @@
 #include "misc.h"
 #include "officethumbprovider.h"
 #include "officeviewerbase.h"
+#include "officelog.h"
 
 OfficeThumbProvider::OfficeThumbProvider(ThumbProvider::Type type, QObject * parent)
     : ThumbProvider(type, parent)
@@ -39,13 +40,14 @@ OfficeThumbProvider::OfficeThumbProvider(ThumbProvider::Type type, QObject * par
 
 OfficeThumbProvider::~OfficeThumbProvider()
 {
-    qDebug() << __PRETTY_FUNCTION__;
+    OFFICE_LOG(Thumbnail) << __PRETTY_FUNCTION__;
 }
 
 void OfficeThumbProvider::init(OfficeViewerBase *newOfficeViewer)
 {
     if(0 != newOfficeViewer) {
         officeViewer = newOfficeViewer;
+        connect(officeViewer, SIGNAL(thumbnailReady(int)), this, SLOT(thumbnailReady(int)));
     }
 
 }
@@ -83,22 +85,26 @@ void OfficeThumbProvider::paint(QPainter *painter, const QStyleOptionGraphicsIte
 
         QPixmap thumbnail;
         if ( !QPixmapCache::find(widget->key(), &thumbnail) ) {
-            qDebug() <<  __PRETTY_FUNCTION__ << startLoading() << m_lastThumbanailSize;
+            OFFICE_LOG(Thumbnail) <<  __PRETTY_FUNCTION__ << startLoading() << m_lastThumbanailSize;
+            QImage image;
             if (startLoading()) {
-                qDebug() << "Stopped scrolling... now lets load the image";
-                QImage *image = officeViewer->getThumbnail(pageIndex);
-                if (image) {
-                    QSizeF pageSize = image->size();
-                    qreal scale = thumbWidth / pageSize.width();
-                    m_lastThumbanailSize = QSizeF(thumbWidth, (pageSize.height() * scale));
-                    widget->setSize(m_lastThumbanailSize, 2);
-                    QPixmap temp(m_lastThumbanailSize.toSize());
-                    temp.convertFromImage(image->scaledToWidth(widget->size().width(), Qt::SmoothTransformation));
-                    widget->setKey(QPixmapCache::insert(temp));
-                    widget->stopSpinner();
-                    painter->drawPixmap(QPointF(0,0), temp, expsRect);
-                    delete image;
+                OFFICE_LOG(Thumbnail) << "Stopped scrolling... now lets load the image";
+                image = officeViewer->thumbnail(pageIndex);
+                if (image.isNull()) {
+                    pendingWidgets.insert(pageIndex, widget);
                 }
+            }
+            if (!image.isNull()) {
+                pendingWidgets.remove(pageIndex);
+                QSizeF pageSize = image.size();
+                qreal scale = thumbWidth / pageSize.width();
+                m_lastThumbanailSize = QSizeF(thumbWidth, (pageSize.height() * scale));
+                widget->setSize(m_lastThumbanailSize, 2);
+                QPixmap temp(m_lastThumbanailSize.toSize());
+                temp.convertFromImage(image.scaledToWidth(widget->size().width(), Qt::SmoothTransformation));
+                widget->setKey(QPixmapCache::insert(temp));
+                widget->stopSpinner();
+                painter->drawPixmap(QPointF(0,0), temp, expsRect);
             } else if (m_lastThumbanailSize.height() > 0) {
                 widget->setSize(m_lastThumbanailSize, 2);
                 widget->startSpinner(expsRect.center());
@@ -107,7 +113,7 @@ void OfficeThumbProvider::paint(QPainter *painter, const QStyleOptionGraphicsIte
             }
         } else {
             if (thumbnail.width() != thumbWidth) {
-                qDebug() << "Thumbnail is scaled to Thumbnail widget ";
+                OFFICE_LOG(Thumbnail) << "Thumbnail is scaled to Thumbnail widget ";
                 QPixmap temp(thumbnail.scaledToWidth(thumbWidth));
                 QPixmapCache::replace(widget->key(), temp);
                 thumbnail = temp;
@@ -142,6 +148,14 @@ void OfficeThumbProvider::updateVisibleAreas()
     }
 }
 
+void OfficeThumbProvider::thumbnailReady(int pageIndex)
+{
+    QPointer<ThumbWidget> widget = pendingWidgets.take(pageIndex);
+    if (widget && widget->getPageIndex() == pageIndex) {
+        widget->update();
+    }
+}
+
 QString OfficeThumbProvider::spreadsheetSheetName(int pageIndex)
 {
     return  officeViewer->sheetName(pageIndex);
@@ -24,6 +24,8 @@
 #ifndef OFFICETHUMBPROVIDER_H
 #define OFFICETHUMBPROVIDER_H
 
+#include <QPointer>
+
 #include "thumbprovider.h"
 
 class OfficeViewerBase;
@@ -64,8 +66,16 @@ public slots:
 
     void updateVisibleAreas();
 
+private slots:
+    /*!
+     * \brief Repaints the widget waiting for the thumbnail of the page
+     */
+    void thumbnailReady(int pageIndex);
+
 private:
     OfficeViewerBase    *officeViewer;
+    //! Widgets showing a spinner until their thumbnail is ready
+    QHash<int, QPointer<ThumbWidget> > pendingWidgets;
 };
 
 #endif //end of OFFICETHUMBPROVIDER_H
@@ -25,6 +25,7 @@
 #define OFFICEVIEWERBASE_H
 
 #include <QGraphicsWidget>
+#include <QImage>
 #include "zoomlevel.h"
 
 class QGraphicsScene;
@@ -74,6 +75,12 @@ signals:
 
     void openingProgress(int value);
 
+    /*!
+     * \brief Emitted when a thumbnail asked for with #thumbnail is ready
+     * \param page is the index of the page
+     */
+    void thumbnailReady(int page);
+
 public:
     /*!
      * \brief Load KOffice document and create a widget for it.
@@ -144,6 +151,24 @@ public:
 
     virtual QImage * getThumbnail(int page) = 0;
 
+    /*!
+     * \brief Gets the thumbnail of a page without blocking.
+     * The default implementation renders it with #getThumbnail.
+     * \param page is the index of the page
+     * \return the thumbnail, or a null image if it is not ready yet in which
+     * case #thumbnailReady is emitted once it is
+     */
+    virtual QImage thumbnail(int page)
+    {
+        QImage *image = getThumbnail(page);
+        if (!image) {
+            return QImage();
+        }
+        QImage result(*image);
+        delete image;
+        return result;
+    }
+
 public slots:
 
     /*!
@@ -47,8 +47,6 @@ PageIndicator::PageIndicator(const QString &documentName, QGraphicsItem *parent)
 {
     m_animation = new QPropertyAnimation(this, "barOffset");
     connect(&timer, SIGNAL(timeout()), this, SLOT(timeoutHide()));
-    connect(ApplicationWindow::GetSceneManager(), SIGNAL(orientationChanged(const M::Orientation &)),
-            this, SLOT(updatePosition(const M::Orientation &)));
     setStyleName("TopToolBarDocument");
     fileNameLabel = new MLabel(documentName, this);
     fileNameLabel->setStyleName("CommonTitleInverted");
@@ -0,0 +1,193 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVariantList>
+
+#include <string.h>
+#include <time.h>
+
+#include "perfcounters.h"
+
+namespace
+{
+    struct CounterInfo {
+        const char *name;
+        //! Current values also report their peak
+        bool gauge;
+    };
+
+    const CounterInfo counterInfo[PerfCounters::CounterCount] = {
+        { "cacheHits", false },
+        { "cacheMisses", false },
+        { "cacheEvictions", false },
+        { "cacheBytes", true },
+        { "renderQueueDepth", true },
+        { "searchedPages", false },
+        { "searchHits", false }
+    };
+
+    const char * const histogramNames[PerfCounters::HistogramCount] = {
+        "renderTime",
+        "thumbnailRenderTime",
+        "pdfPaintTime",
+        "searchTime"
+    };
+
+    //! Upper limits of the histogram buckets in microseconds, the last
+    //! bucket takes everything above
+    const qint64 bucketLimits[] = {
+        500, 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000, 256000, 512000, 1024000
+    };
+
+    const int BucketCount = sizeof(bucketLimits) / sizeof bucketLimits[0] + 1;
+
+    struct HistogramData {
+        qint64 buckets[BucketCount];
+        qint64 count;
+        qint64 total;
+        qint64 maximum;
+    };
+
+    class CounterData
+    {
+    public:
+        CounterData()
+        {
+            clear();
+        }
+
+        void clear()
+        {
+            memset(values, 0, sizeof values);
+            memset(peaks, 0, sizeof peaks);
+            memset(histograms, 0, sizeof histograms);
+        }
+
+        QMutex mutex;
+        qint64 values[PerfCounters::CounterCount];
+        qint64 peaks[PerfCounters::CounterCount];
+        HistogramData histograms[PerfCounters::HistogramCount];
+    };
+}
+
+static CounterData &counterData()
+{
+    static CounterData data;
+    return data;
+}
+
+void PerfCounters::add(Counter counter, qint64 value)
+{
+    CounterData &data = counterData();
+    QMutexLocker lock(&data.mutex);
+    data.values[counter] += value;
+    data.peaks[counter] = qMax(data.peaks[counter], data.values[counter]);
+}
+
+void PerfCounters::set(Counter counter, qint64 value)
+{
+    CounterData &data = counterData();
+    QMutexLocker lock(&data.mutex);
+    data.values[counter] = value;
+    data.peaks[counter] = qMax(data.peaks[counter], value);
+}
+
+void PerfCounters::addSample(Histogram histogram, qint64 microseconds)
+{
+    int bucket = 0;
+    while (bucket < BucketCount - 1 && microseconds > bucketLimits[bucket]) {
+        ++bucket;
+    }
+
+    CounterData &data = counterData();
+    QMutexLocker lock(&data.mutex);
+    HistogramData &histogramData = data.histograms[histogram];
+    histogramData.buckets[bucket]++;
+    histogramData.count++;
+    histogramData.total += microseconds;
+    histogramData.maximum = qMax(histogramData.maximum, microseconds);
+}
+
+QVariantMap PerfCounters::values()
+{
+    CounterData &data = counterData();
+    QMutexLocker lock(&data.mutex);
+
+    QVariantMap result;
+    for (int i = 0; i < CounterCount; ++i) {
+        const QString name(counterInfo[i].name);
+        result[name] = data.values[i];
+        if (counterInfo[i].gauge) {
+            result[name + ".peak"] = data.peaks[i];
+        }
+    }
+
+    QVariantList limits;
+    for (int i = 0; i < BucketCount - 1; ++i) {
+        limits.append(bucketLimits[i]);
+    }
+    result["bucketLimitsUs"] = limits;
+
+    for (int i = 0; i < HistogramCount; ++i) {
+        const QString name(histogramNames[i]);
+        const HistogramData &histogramData = data.histograms[i];
+        QVariantList buckets;
+        for (int bucket = 0; bucket < BucketCount; ++bucket) {
+            buckets.append(histogramData.buckets[bucket]);
+        }
+        result[name + ".buckets"] = buckets;
+        result[name + ".count"] = histogramData.count;
+        result[name + ".totalUs"] = histogramData.total;
+        result[name + ".maxUs"] = histogramData.maximum;
+    }
+
+    const qint64 lookups = data.values[CacheHits] + data.values[CacheMisses];
+    result["cacheHitRatio"] = lookups > 0 ? qreal(data.values[CacheHits]) / lookups : 0.0;
+
+    const qint64 searchTime = data.histograms[SearchTime].total;
+    result["searchPagesPerSecond"] = searchTime > 0 ? data.values[SearchedPages] * 1000000.0 / searchTime : 0.0;
+
+    return result;
+}
+
+void PerfCounters::reset()
+{
+    CounterData &data = counterData();
+    QMutexLocker lock(&data.mutex);
+    // the cache and the queues still hold what they hold
+    const qint64 cacheBytes = data.values[CacheBytes];
+    const qint64 queueDepth = data.values[RenderQueueDepth];
+    data.clear();
+    data.values[CacheBytes] = data.peaks[CacheBytes] = cacheBytes;
+    data.values[RenderQueueDepth] = data.peaks[RenderQueueDepth] = queueDepth;
+}
+
+qint64 PerfCounters::now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return qint64(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
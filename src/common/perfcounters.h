@@ -0,0 +1,189 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <QVariantMap>
+#include <QCache>
+
+#include <common_export.h>
+
+/*!
+ * \class PerfCounters
+ * \brief Process wide performance counters
+ *
+ * The counters are always collected, they are cheap enough for release
+ * builds, and are read over D-Bus with the perfCounters method of the
+ * office tools service.
+ */
+class COMMON_EXPORT PerfCounters
+{
+public:
+    enum Counter {
+        //! Page images found in the cache, also when they were scaled, and
+        //! thumbnails, slides and canvas tiles found in theirs
+        CacheHits,
+        //! Page images, thumbnails, slides and canvas tiles that had to be rendered
+        CacheMisses,
+        //! Entries dropped to keep the caches within their size
+        CacheEvictions,
+        //! Bytes used by the page images, thumbnails, slides and canvas tiles
+        CacheBytes,
+        //! Pages and thumbnails waiting in the render queues of all documents
+        RenderQueueDepth,
+        //! Pages searched for text
+        SearchedPages,
+        //! Search results found
+        SearchHits,
+        CounterCount
+    };
+
+    enum Histogram {
+        //! Poppler render time of a page
+        RenderTime,
+        //! Poppler render time of a thumbnail
+        ThumbnailRenderTime,
+        //! Time spent painting one PDF page widget
+        PdfPaintTime,
+        //! Time spent searching one page
+        SearchTime,
+        HistogramCount
+    };
+
+    /*!
+     * \brief Adds to a counter, a negative value decreases it
+     */
+    static void add(Counter counter, qint64 value = 1);
+
+    /*!
+     * \brief Sets a counter that holds a current value like a queue length
+     */
+    static void set(Counter counter, qint64 value);
+
+    /*!
+     * \brief Adds a duration in microseconds to a histogram
+     */
+    static void addSample(Histogram histogram, qint64 microseconds);
+
+    /*!
+     * \brief All counters and histograms by name, with the cache hit ratio
+     * and the search throughput worked out
+     */
+    static QVariantMap values();
+
+    static void reset();
+
+    //! Monotonic time in microseconds
+    static qint64 now();
+};
+
+/*!
+ * \class PerfTimer
+ * \brief Adds the lifetime of the object to a histogram
+ */
+class COMMON_EXPORT PerfTimer
+{
+public:
+    explicit PerfTimer(PerfCounters::Histogram histogram)
+        : m_histogram(histogram)
+        , m_start(PerfCounters::now())
+    {
+    }
+
+    ~PerfTimer()
+    {
+        PerfCounters::addSample(m_histogram, PerfCounters::now() - m_start);
+    }
+
+private:
+    Q_DISABLE_COPY(PerfTimer)
+
+    PerfCounters::Histogram m_histogram;
+    qint64 m_start;
+};
+
+/*!
+ * \class CountedCache
+ * \brief QCache which keeps CacheBytes and CacheEvictions up to date
+ *
+ * The cost of an entry must be its size in bytes. Hits and misses are
+ * counted by the users, which know when a lookup is more than a check.
+ */
+template <class Key, class T>
+class CountedCache : public QCache<Key, T>
+{
+public:
+    explicit CountedCache(int maxCost = 100)
+        : QCache<Key, T>(maxCost)
+    {
+    }
+
+    ~CountedCache()
+    {
+        clear();
+    }
+
+    bool insert(const Key &key, T *object, int cost = 1)
+    {
+        const int entries = this->count() + (this->contains(key) ? 0 : 1);
+        const int totalCost = this->totalCost();
+        const bool inserted = QCache<Key, T>::insert(key, object, cost);
+        counted(entries, totalCost);
+        return inserted;
+    }
+
+    bool remove(const Key &key)
+    {
+        const int totalCost = this->totalCost();
+        const bool removed = QCache<Key, T>::remove(key);
+        PerfCounters::add(PerfCounters::CacheBytes, this->totalCost() - totalCost);
+        return removed;
+    }
+
+    void clear()
+    {
+        PerfCounters::add(PerfCounters::CacheBytes, -this->totalCost());
+        QCache<Key, T>::clear();
+    }
+
+    void setMaxCost(int maxCost)
+    {
+        const int entries = this->count();
+        const int totalCost = this->totalCost();
+        QCache<Key, T>::setMaxCost(maxCost);
+        counted(entries, totalCost);
+    }
+
+private:
+    void counted(int entries, int totalCost)
+    {
+        PerfCounters::add(PerfCounters::CacheBytes, this->totalCost() - totalCost);
+        if (this->count() < entries) {
+            PerfCounters::add(PerfCounters::CacheEvictions, entries - this->count());
+        }
+    }
+};
+
+#endif // PERFCOUNTERS_H
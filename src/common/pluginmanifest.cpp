@@ -0,0 +1,178 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSettings>
+#include <QPluginLoader>
+#include <QGraphicsWidget>
+#include <QDebug>
+
+#include "pluginmanifest.h"
+#include "OfficeInterface.h"
+
+namespace
+{
+    const char PluginPath[] = "/usr/lib/office-tools/plugins";
+
+    QString cacheFileName()
+    {
+        return QDir::homePath() + "/.cache/office-tools/plugins.cache";
+    }
+
+    QList<PluginManifest::Entry> readManifest()
+    {
+        QList<PluginManifest::Entry> entries;
+
+        const QDir pluginDir(PluginPath);
+        const QFileInfoList plugins = pluginDir.entryInfoList(QDir::Files);
+
+        QSettings cache(cacheFileName(), QSettings::NativeFormat);
+        const QStringList cached = cache.childGroups();
+        bool changed = false;
+
+        for (int i = 0; i < plugins.size(); ++i) {
+            const QFileInfo &info = plugins.at(i);
+            const QString key = info.fileName();
+
+            PluginManifest::Entry entry;
+            entry.path = info.absoluteFilePath();
+
+            cache.beginGroup(key);
+            if (cache.value("mtime").toDateTime() == info.lastModified()) {
+                entry.name = cache.value("name").toString();
+                entry.type = cache.value("type").toString();
+            } else {
+                // New or updated plugin, this is the only time it is loaded
+                // before its action is used
+                QPluginLoader loader(entry.path);
+                OfficeInterface *plugin = qobject_cast<OfficeInterface*>(loader.instance());
+                if (plugin) {
+                    entry.name = plugin->pluginName();
+                    entry.type = plugin->pluginType();
+                } else {
+                    qWarning() << __PRETTY_FUNCTION__ << entry.path << loader.errorString();
+                }
+                loader.unload();
+
+                cache.setValue("mtime", info.lastModified());
+                cache.setValue("name", entry.name);
+                cache.setValue("type", entry.type);
+                changed = true;
+            }
+            cache.endGroup();
+
+            if (!entry.type.isEmpty()) {
+                entries.append(entry);
+            }
+        }
+
+        // Forget the plugins which were removed
+        for (int i = 0; i < cached.size(); ++i) {
+            if (!pluginDir.exists(cached.at(i))) {
+                cache.remove(cached.at(i));
+                changed = true;
+            }
+        }
+
+        if (changed) {
+            QDir().mkpath(QFileInfo(cacheFileName()).path());
+            cache.sync();
+        }
+
+        return entries;
+    }
+}
+
+QList<PluginManifest::Entry> PluginManifest::plugins(const QString &type)
+{
+    // Plugins are only installed with packages, once per process is enough
+    static const QList<Entry> manifest = readManifest();
+
+    QList<Entry> result;
+    foreach (const Entry &entry, manifest) {
+        if (entry.type == type) {
+            result.append(entry);
+        }
+    }
+    return result;
+}
+
+void PluginManifest::addActions(QGraphicsWidget *widget, const QString &type,
+                                QObject *receiver, const char *member)
+{
+    // The actions are added again after the quick viewer removed them, the
+    // ones created before are reused
+    const QList<PluginAction *> created = widget->findChildren<PluginAction *>();
+
+    foreach (const Entry &entry, plugins(type)) {
+        PluginAction *pluginAction = 0;
+        foreach (PluginAction *action, created) {
+            if (action->pluginPath() == entry.path) {
+                pluginAction = action;
+                break;
+            }
+        }
+
+        if (!pluginAction) {
+            pluginAction = new PluginAction(entry, receiver, member, widget);
+            pluginAction->setLocation(MAction::ApplicationMenuLocation);
+        }
+        widget->addAction(pluginAction);
+    }
+}
+
+PluginAction::PluginAction(const PluginManifest::Entry &entry, QObject *target,
+                           const char *member, QObject *parent)
+    : MAction(entry.name, parent)
+    , path(entry.path)
+    , target(target)
+    , member(member)
+{
+    connect(this, SIGNAL(triggered()), this, SLOT(openPlugin()));
+}
+
+QString PluginAction::pluginPath() const
+{
+    return path;
+}
+
+void PluginAction::openPlugin()
+{
+    QPluginLoader loader(path);
+    QObject *plugin = loader.instance();
+    if (!qobject_cast<OfficeInterface*>(plugin)) {
+        qWarning() << __PRETTY_FUNCTION__ << path << loader.errorString();
+        return;
+    }
+
+    // The plugin instance is shared by all pages, so it is only connected to
+    // the target for the time of this request
+    if (target) {
+        connect(plugin, SIGNAL(openMe(OfficeInterface*)), target, member.constData());
+        QMetaObject::invokeMethod(plugin, "emitOpenSignal");
+        disconnect(plugin, SIGNAL(openMe(OfficeInterface*)), target, member.constData());
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef PLUGINMANIFEST_H
+#define PLUGINMANIFEST_H
+
+#include <QList>
+#include <QPointer>
+#include <QString>
+
+#include <MAction>
+
+#include <common_export.h>
+
+class QGraphicsWidget;
+
+/*!
+ * \class PluginManifest
+ * \brief Knows the name and type of the office-tools extension plugins
+ * without loading them.
+ *
+ * The names and types are kept in a cache file together with the
+ * modification time of each plugin library. Only a plugin which is new or
+ * has changed since is loaded to ask them, and unloaded again.
+ */
+class COMMON_EXPORT PluginManifest
+{
+public:
+    struct Entry {
+        //! Absolute path of the plugin library
+        QString path;
+        //! OfficeInterface::pluginName()
+        QString name;
+        //! OfficeInterface::pluginType()
+        QString type;
+    };
+
+    /*!
+     * \brief Returns the plugins of given type
+     * \param type generic, document or pdf, see OfficeInterface::pluginType()
+     */
+    static QList<Entry> plugins(const QString &type);
+
+    /*!
+     * \brief Adds an application menu action for each plugin of given type.
+     * The plugin is loaded when its action is triggered and then handed to
+     * member of receiver, a slot taking an OfficeInterface pointer. Actions
+     * created for the widget before are added again instead of new ones.
+     */
+    static void addActions(QGraphicsWidget *widget, const QString &type,
+                           QObject *receiver, const char *member);
+};
+
+/*!
+ * \class PluginAction
+ * \brief Menu action which loads its plugin when triggered
+ */
+class COMMON_EXPORT PluginAction : public MAction
+{
+    Q_OBJECT
+
+public:
+    PluginAction(const PluginManifest::Entry &entry, QObject *target,
+                 const char *member, QObject *parent);
+
+    //! Absolute path of the plugin library
+    QString pluginPath() const;
+
+private slots:
+    void openPlugin();
+
+private:
+    QString path;
+    QPointer<QObject> target;
+    QByteArray member;
+};
+
+#endif // PLUGINMANIFEST_H
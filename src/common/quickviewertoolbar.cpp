@@ -1,5 +1,4 @@
 #include "quickviewertoolbar.h"
-#include "applicationwindow.h"
 #include "documentpage.h"
 
 #include <MButton>
@@ -37,8 +36,6 @@ QuickViewerToolbar::QuickViewerToolbar(QGraphicsItem *parent)
     toolbarLayout->addItem(saveButton, 0, 2, Qt::AlignTop | Qt::AlignRight);
     setPos(0, 0);
     setZValue(FLT_MAX);
-    connect(ApplicationWindow::GetSceneManager(), SIGNAL(orientationChanged(const M::Orientation &)),
-            this, SLOT(updatePosition(const M::Orientation &)));
 }
 
 QGraphicsWidget *QuickViewerToolbar::createSpacer()
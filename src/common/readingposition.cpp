@@ -0,0 +1,109 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QDir>
+#include <QSettings>
+#include <QDateTime>
+#include <QCryptographicHash>
+
+#include "readingposition.h"
+#include "definitions.h"
+
+namespace
+{
+    QString positionFileName()
+    {
+        return QDir::homePath() + "/.config/office-tools/positions.cfg";
+    }
+
+    QString positionKey(const QString &documentPath)
+    {
+        // Paths contain the settings group separator
+        return QCryptographicHash::hash(documentPath.toUtf8(), QCryptographicHash::Md5).toHex();
+    }
+}
+
+ReadingPosition::ReadingPosition()
+    : page(-1)
+    , zoom(ZoomLevel::FitToWidth, 1.0, false)
+{
+}
+
+ReadingPosition ReadingPosition::load(const QString &documentPath)
+{
+    ReadingPosition position;
+
+    QSettings settings(positionFileName(), QSettings::NativeFormat);
+    settings.beginGroup(positionKey(documentPath));
+    if (settings.contains("page")) {
+        position.page = settings.value("page").toInt();
+        position.offset = settings.value("offset").toPointF();
+
+        const ZoomLevel::Mode mode = static_cast<ZoomLevel::Mode>(settings.value("zoomMode").toInt());
+        const qreal factor = settings.value("zoomFactor", 1.0).toReal();
+        position.zoom = ZoomLevel(mode, factor, mode == ZoomLevel::FactorMode);
+    }
+    settings.endGroup();
+
+    return position;
+}
+
+void ReadingPosition::save(const QString &documentPath) const
+{
+    if (!isValid()) {
+        return;
+    }
+
+    qreal factor = 1.0;
+    zoom.getFactor(factor);
+
+    QSettings settings(positionFileName(), QSettings::NativeFormat);
+    settings.beginGroup(positionKey(documentPath));
+    settings.setValue("page", page);
+    settings.setValue("offset", offset);
+    settings.setValue("zoomMode", static_cast<int>(zoom.getMode()));
+    settings.setValue("zoomFactor", factor);
+    settings.setValue("time", QDateTime::currentDateTime());
+    settings.endGroup();
+
+    QStringList documents = settings.childGroups();
+    while (documents.size() > MaxReadingPositions) {
+        QString oldest;
+        QDateTime oldestTime;
+        foreach (const QString &document, documents) {
+            const QDateTime time = settings.value(document + "/time").toDateTime();
+            if (oldest.isEmpty() || time < oldestTime) {
+                oldest = document;
+                oldestTime = time;
+            }
+        }
+        settings.remove(oldest);
+        documents.removeAll(oldest);
+    }
+}
+
+bool ReadingPosition::isValid() const
+{
+    return page >= 0;
+}
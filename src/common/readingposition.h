@@ -0,0 +1,69 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef READINGPOSITION_H
+#define READINGPOSITION_H
+
+#include <QPointF>
+#include <QString>
+
+#include "zoomlevel.h"
+#include <common_export.h>
+
+/*!
+ * \class ReadingPosition
+ * \brief Where the user was in a document when it was closed
+ *
+ * The positions of the last MaxReadingPositions documents are kept, so that
+ * a document opens again at the same page and zoom.
+ */
+class COMMON_EXPORT ReadingPosition
+{
+public:
+    ReadingPosition();
+
+    /*!
+     * \brief Reads the stored position of a document
+     * \param documentPath The local path of the document
+     * \return The position, not valid if none was stored
+     */
+    static ReadingPosition load(const QString &documentPath);
+
+    /*!
+     * \brief Stores the position, dropping the oldest one when there are
+     * too many
+     */
+    void save(const QString &documentPath) const;
+
+    bool isValid() const;
+
+    //! Index of the page, -1 for no position
+    int page;
+    //! Top left corner of the view relative to the page size
+    QPointF offset;
+    //! Zoom level, either one of the fit modes or a factor
+    ZoomLevel zoom;
+};
+
+#endif // READINGPOSITION_H
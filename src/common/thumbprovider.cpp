@@ -25,6 +25,7 @@
 
 #include "thumbprovider.h"
 #include "misc.h"
+#include "officelog.h"
 
 ThumbProvider::ThumbProvider(Type type, QObject * parent)
     : QObject(parent)
@@ -36,7 +37,7 @@ ThumbProvider::ThumbProvider(Type type, QObject * parent)
 
 ThumbProvider::~ThumbProvider()
 {
-    qDebug() << __PRETTY_FUNCTION__;
+    OFFICE_LOG(Thumbnail) << __PRETTY_FUNCTION__;
 }
 
 
@@ -35,6 +35,7 @@
 #include "thumbprovider.h"
 #include "definitions.h"
 #include "officethumbprovider.h"
+#include "officelog.h"
 
 ThumbWidget::ThumbWidget(ThumbProvider *thumbProvider, bool thumbForSpreadSheet, QGraphicsItem *parent)
     : MWidgetController(parent)
@@ -51,7 +52,7 @@ ThumbWidget::ThumbWidget(ThumbProvider *thumbProvider, bool thumbForSpreadSheet,
 
 ThumbWidget::~ThumbWidget()
 {
-    qDebug() << __PRETTY_FUNCTION__;
+    OFFICE_LOG(Thumbnail) << __PRETTY_FUNCTION__;
 }
 
 void ThumbWidget::setPageIndex(int newPageIndex, int pageCount)
@@ -82,7 +83,7 @@ void ThumbWidget::paint(QPainter *painter, const QStyleOptionGraphicsItem *optio
 {
     Q_UNUSED(widget);
 
-    qDebug() << "in Paint method ---------------" << pageIndex;
+    OFFICE_LOG(Thumbnail) << "in Paint method ---------------" << pageIndex;
     currentpageIndex = thumbProvider->getPageIndex();
     QPen pen = painter->pen();
     pen.setWidth(2);
@@ -158,7 +159,7 @@ void ThumbWidget::setHighlightNames(QString prefix)
 
 void ThumbWidget::startSpinner(const QPointF &pos)
 {
-    qDebug() << __PRETTY_FUNCTION__;
+    OFFICE_LOG(Thumbnail) << __PRETTY_FUNCTION__;
     if (!m_spinner) {
         m_spinner = new MProgressIndicator(this, MProgressIndicator::spinnerType);
         m_spinner->setStyleName("CommonThumbnailSpinner");
@@ -0,0 +1,190 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <QDebug>
+
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "tracepoint.h"
+#include "definitions.h"
+
+namespace
+{
+    struct TraceEvent {
+        const char *name;
+        const char *category;
+        const char *key;
+        qint64 value;
+        qint64 timestamp;
+        //! Duration in microseconds, -1 for instant events
+        qint64 duration;
+        long thread;
+    };
+
+    class TraceBuffer
+    {
+    public:
+        TraceBuffer()
+            : postRoutineAdded(false)
+            , overflow(false)
+        {
+        }
+
+        QMutex mutex;
+        QVector<TraceEvent> events;
+        bool postRoutineAdded;
+        bool overflow;
+    };
+}
+
+static const char TraceVariable[] = "OFFICE_TOOLS_TRACE";
+
+bool TracePoint::enabled = !qgetenv(TraceVariable).isEmpty();
+
+static TraceBuffer &traceBuffer()
+{
+    static TraceBuffer buffer;
+    return buffer;
+}
+
+static qint64 traceTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return qint64(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+static void addEvent(const TraceEvent &event)
+{
+    TraceBuffer &buffer = traceBuffer();
+    QMutexLocker lock(&buffer.mutex);
+    if (!buffer.postRoutineAdded) {
+        buffer.postRoutineAdded = true;
+        qAddPostRoutine(TracePoint::flush);
+    }
+    if (buffer.events.size() >= MaxTraceEvents) {
+        if (!buffer.overflow) {
+            buffer.overflow = true;
+            qWarning() << __PRETTY_FUNCTION__ << "trace buffer full, dropping events";
+        }
+        return;
+    }
+    buffer.events.append(event);
+}
+
+void TracePoint::begin(const char *name, const char *category)
+{
+    m_name = name;
+    m_category = category;
+    m_key = 0;
+    m_value = 0;
+    m_start = traceTime();
+}
+
+void TracePoint::end()
+{
+    TraceEvent event;
+    event.name = m_name;
+    event.category = m_category;
+    event.key = m_key;
+    event.value = m_value;
+    event.timestamp = m_start;
+    event.duration = traceTime() - m_start;
+    event.thread = syscall(SYS_gettid);
+    addEvent(event);
+}
+
+void TracePoint::record(const char *name, const char *category,
+                        const char *key, qint64 value)
+{
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.key = key;
+    event.value = value;
+    event.timestamp = traceTime();
+    event.duration = -1;
+    event.thread = syscall(SYS_gettid);
+    addEvent(event);
+}
+
+void TracePoint::flush()
+{
+    if (!enabled) {
+        return;
+    }
+
+    const QByteArray pid = QByteArray::number(getpid());
+    QString fileName = QString::fromLocal8Bit(qgetenv(TraceVariable));
+    fileName.replace("%p", QString(pid));
+
+    TraceBuffer &buffer = traceBuffer();
+    QMutexLocker lock(&buffer.mutex);
+
+    QByteArray json("{\"traceEvents\":[\n");
+    for (int i = 0; i < buffer.events.size(); ++i) {
+        const TraceEvent &event = buffer.events.at(i);
+        if (i > 0) {
+            json += ",\n";
+        }
+        json += "{\"name\":\"";
+        json += event.name;
+        json += "\",\"cat\":\"";
+        json += event.category;
+        if (event.duration < 0) {
+            json += "\",\"ph\":\"i\",\"s\":\"t\"";
+        } else {
+            json += "\",\"ph\":\"X\",\"dur\":";
+            json += QByteArray::number(event.duration);
+        }
+        json += ",\"ts\":";
+        json += QByteArray::number(event.timestamp);
+        json += ",\"pid\":";
+        json += pid;
+        json += ",\"tid\":";
+        json += QByteArray::number(qint64(event.thread));
+        if (event.key) {
+            json += ",\"args\":{\"";
+            json += event.key;
+            json += "\":";
+            json += QByteArray::number(event.value);
+            json += "}";
+        }
+        json += "}";
+    }
+    json += "\n]}\n";
+    lock.unlock();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+        qWarning() << __PRETTY_FUNCTION__ << "failed to write" << fileName << file.errorString();
+    }
+}
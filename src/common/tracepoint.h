@@ -0,0 +1,115 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef TRACEPOINT_H
+#define TRACEPOINT_H
+
+#include <QtGlobal>
+
+#include <common_export.h>
+
+/*!
+ * \class TracePoint
+ * \brief Records how long a scope took for a Chrome trace-event file
+ *
+ * Tracing is switched on by setting OFFICE_TOOLS_TRACE to the name of the
+ * file to write, a "%p" in the name is replaced by the process id. The
+ * events are kept in memory and written when the application object is
+ * destroyed, the file can be opened in chrome://tracing.
+ *
+ * When tracing is off a trace point costs a test of one flag, so they can
+ * stay in the code. Names and categories must be string literals, only the
+ * pointers are stored.
+ */
+class COMMON_EXPORT TracePoint
+{
+public:
+    /*!
+     * \brief Starts a complete ("X") event that ends with the object
+     * \param name The name of the event
+     * \param category The category of the event
+     */
+    TracePoint(const char *name, const char *category)
+        : m_name(0)
+    {
+        if (enabled) {
+            begin(name, category);
+        }
+    }
+
+    ~TracePoint()
+    {
+        if (m_name) {
+            end();
+        }
+    }
+
+    /*!
+     * \brief Attaches a value to the event, e.g. the page index
+     */
+    void setArgument(const char *key, qint64 value)
+    {
+        m_key = key;
+        m_value = value;
+    }
+
+    /*!
+     * \brief Records an instant ("i") event
+     */
+    static void mark(const char *name, const char *category,
+                     const char *key = 0, qint64 value = 0)
+    {
+        if (enabled) {
+            record(name, category, key, value);
+        }
+    }
+
+    static bool isEnabled()
+    {
+        return enabled;
+    }
+
+    /*!
+     * \brief Writes the events recorded so far to the trace file
+     */
+    static void flush();
+
+private:
+    Q_DISABLE_COPY(TracePoint)
+
+    void begin(const char *name, const char *category);
+    void end();
+    static void record(const char *name, const char *category,
+                       const char *key, qint64 value);
+
+    static bool enabled;
+
+    const char *m_name;
+    const char *m_category;
+    const char *m_key;
+    qint64 m_value;
+    qint64 m_start;
+};
+
+#endif // TRACEPOINT_H
@@ -14,6 +14,29 @@
 #include <QUrl>
 #include <QFileInfo>
 
+namespace
+{
+//! Returns the url in the form it is stored in nie:url
+QString trackerUrl(const QUrl &url)
+{
+    QString resolvedUrl = url.toEncoded();
+    if (resolvedUrl.startsWith('/')) {
+        resolvedUrl = resolvedUrl.insert(0, "file://");
+    }
+    return resolvedUrl;
+}
+
+const char * const DocumentDetailsQuery =
+    "SELECT ?mt ?la ?bs ?add ?sb ?cr ?pub WHERE  { ?:urn a nfo:Document; nie:mimeType ?mt ; "\
+    "nfo:fileLastAccessed ?la ; nie:byteSize ?bs ; tracker:added ?add ." \
+    "OPTIONAL {  ?:urn nie:subject ?sb }"   \
+    "OPTIONAL {  ?:urn nco:creator ?aut ."  \
+                 "?aut nco:fullname ?cr }"  \
+    "OPTIONAL {  ?:urn nco:publisher ?nm ." \
+                 "?nm nco:fullname ?pub }"  \
+    "}";
+}
+
 QSharedPointer<TrackerUtils> TrackerUtils::m_instance;
 
 TrackerUtils & TrackerUtils::Instance()
@@ -41,39 +64,57 @@ TrackerUtils::~TrackerUtils()
 }
 
 void TrackerUtils::markItemAsFavorite(const QString& itemUrn)
+{
+    updateFavoriteTag(itemUrn, true);
+}
+
+void TrackerUtils::unmarkItemAsFavorite(const QString& itemUrn)
+{
+    updateFavoriteTag(itemUrn, false);
+}
+
+void TrackerUtils::updateFavoriteTag(const QString &itemUrn, bool favorite)
 {
     if (itemUrn.isEmpty()) {
         return;
     }
-    qDebug() << __PRETTY_FUNCTION__;
+    qDebug() << __PRETTY_FUNCTION__ << favorite;
 
-    static QSparqlQuery query("INSERT { ?:urn nao:hasTag nao:predefined-tag-favorite }",
-                              QSparqlQuery::InsertStatement);
+    static QSparqlQuery insertQuery("INSERT { ?:urn nao:hasTag nao:predefined-tag-favorite }",
+                                    QSparqlQuery::InsertStatement);
+    static QSparqlQuery deleteQuery("DELETE { ?:urn nao:hasTag nao:predefined-tag-favorite }",
+                                    QSparqlQuery::DeleteStatement);
+    QSparqlQuery &query = favorite ? insertQuery : deleteQuery;
     query.bindValue("urn", QUrl(itemUrn));
+    cacheFavoriteStatus(itemUrn, favorite);
 
     QSparqlResult *result = m_connection->exec(query);
     connect(result, SIGNAL(finished()),
             m_instance.data(), SLOT(deleteResult()));
 }
 
-void TrackerUtils::unmarkItemAsFavorite(const QString& itemUrn)
+void TrackerUtils::toggleItemFavorite(const QString& itemUrn)
 {
     if (itemUrn.isEmpty()) {
         return;
     }
-    qDebug() << __PRETTY_FUNCTION__;
+    if (m_favoriteForUrn.contains(itemUrn)) {
+        updateFavoriteTag(itemUrn, !m_favoriteForUrn.value(itemUrn));
+        return;
+    }
 
-    static QSparqlQuery query("DELETE { ?:urn nao:hasTag nao:predefined-tag-favorite }",
-                              QSparqlQuery::DeleteStatement);
+    static QSparqlQuery query("ASK { ?:urn nao:hasTag nao:predefined-tag-favorite }",
+                              QSparqlQuery::AskStatement);
     query.bindValue("urn", QUrl(itemUrn));
-
-    QSparqlResult *result = m_connection->exec(query);
-    connect(result, SIGNAL(finished()),
-            m_instance.data(), SLOT(deleteResult()));
+    startRequest(query, FavoriteToggleRequest, QUrl(), itemUrn);
 }
 
 bool TrackerUtils::isItemMarkedAsFavorite(const QString& itemUrn)
 {
+    if (m_favoriteForUrn.contains(itemUrn)) {
+        return m_favoriteForUrn.value(itemUrn);
+    }
+
     static QSparqlQuery query("ASK { ?:urn nao:hasTag nao:predefined-tag-favorite }",
                               QSparqlQuery::AskStatement);
     query.bindValue("urn", QUrl(itemUrn));
@@ -82,6 +123,31 @@ bool TrackerUtils::isItemMarkedAsFavorite(const QString& itemUrn)
     if (result == 0) {
         return false;
     }
+    bool value = readFavorite(result, itemUrn);
+
+    delete result;
+    return value;
+}
+
+void TrackerUtils::requestFavoriteStatus(const QString& itemUrn)
+{
+    if (itemUrn.isEmpty()) {
+        emit favoriteStatusReady(itemUrn, false);
+        return;
+    }
+    if (m_favoriteForUrn.contains(itemUrn)) {
+        emit favoriteStatusReady(itemUrn, m_favoriteForUrn.value(itemUrn));
+        return;
+    }
+
+    static QSparqlQuery query("ASK { ?:urn nao:hasTag nao:predefined-tag-favorite }",
+                              QSparqlQuery::AskStatement);
+    query.bindValue("urn", QUrl(itemUrn));
+    startRequest(query, FavoriteStatusRequest, QUrl(), itemUrn);
+}
+
+bool TrackerUtils::readFavorite(QSparqlResult *result, const QString &itemUrn)
+{
     result->next();
     bool value(false);
     if (result->hasError()) {
@@ -90,9 +156,8 @@ bool TrackerUtils::isItemMarkedAsFavorite(const QString& itemUrn)
                  result->lastError().message().toAscii().data());
     } else {
         value = result->value(0).toBool();
+        m_favoriteForUrn.insert(itemUrn, value);
     }
-
-    delete result;
     return value;
 }
 
@@ -120,12 +185,38 @@ QUrl TrackerUtils::urlFromUrn(const QString& urn)
     if ( urn.isEmpty() ) {
         return QUrl();
     }
+    if (m_urlForUrn.contains(urn)) {
+        return QUrl::fromEncoded(m_urlForUrn.value(urn).toAscii());
+    }
 
     static QSparqlQuery query("SELECT ?url WHERE { ?:urn nie:url ?url . }");
     query.bindValue("urn", QUrl(urn));
 
     QSparqlResult *result = m_connection->syncExec(query);
+    QUrl value = readUrl(result, urn);
+
+    delete result;
+    return value;
+}
+
+void TrackerUtils::requestUrlFromUrn(const QString& urn)
+{
+    if (urn.isEmpty()) {
+        emit urlFromUrnReady(urn, QUrl());
+        return;
+    }
+    if (m_urlForUrn.contains(urn)) {
+        emit urlFromUrnReady(urn, QUrl::fromEncoded(m_urlForUrn.value(urn).toAscii()));
+        return;
+    }
+
+    static QSparqlQuery query("SELECT ?url WHERE { ?:urn nie:url ?url . }");
+    query.bindValue("urn", QUrl(urn));
+    startRequest(query, UrlFromUrnRequest, QUrl(), urn);
+}
 
+QUrl TrackerUtils::readUrl(QSparqlResult *result, const QString &urn)
+{
     QUrl value;
     if (result->hasError()) {
         qWarning("Could not map URN %s to an URL: %s",
@@ -137,9 +228,8 @@ QUrl TrackerUtils::urlFromUrn(const QString& urn)
                  urn.toAscii().data());
     } else {
         value = result->value(0).toUrl();
+        cacheUrn(trackerUrl(value), urn);
     }
-
-    delete result;
     return value;
 }
 
@@ -149,29 +239,54 @@ QString TrackerUtils::urnFromUrl(const QUrl& url)
         return QString();
     }
 
-    QString resolvedUrl = url.toEncoded();
-    if (resolvedUrl.startsWith('/')) {
-        resolvedUrl = resolvedUrl.insert(0, "file://");
+    QString resolvedUrl = trackerUrl(url);
+    if (m_urnForUrl.contains(resolvedUrl)) {
+        return m_urnForUrl.value(resolvedUrl);
     }
 
     static QSparqlQuery query("SELECT ?urn WHERE { ?urn nie:url ?:url . }");
     query.bindValue("url", resolvedUrl);
     QSparqlResult *result = m_connection->syncExec(query);
+    QString value = readUrn(result, url);
+
+    delete result;
+    return value;
+}
+
+void TrackerUtils::requestUrnFromUrl(const QUrl& url)
+{
+    if (url.isEmpty()) {
+        emit urnFromUrlReady(url, QString());
+        return;
+    }
+
+    QString resolvedUrl = trackerUrl(url);
+    if (m_urnForUrl.contains(resolvedUrl)) {
+        emit urnFromUrlReady(url, m_urnForUrl.value(resolvedUrl));
+        return;
+    }
 
+    static QSparqlQuery query("SELECT ?urn WHERE { ?urn nie:url ?:url . }");
+    query.bindValue("url", resolvedUrl);
+    startRequest(query, UrnFromUrlRequest, url, resolvedUrl);
+}
+
+QString TrackerUtils::readUrn(QSparqlResult *result, const QUrl &url)
+{
     QString value;
     if (result->hasError()) {
         qWarning("Could not map URL %s to an URN: %s",
                  url.toString().toAscii().data(),
                  result->lastError().message().toAscii().data());
     } else if (!result->first()) {
+        // Not cached: the file may still get indexed later on
         qWarning("URL %s does not have an associated URN "
                  "(in general this should not happen)",
                  url.toString().toAscii().data());
     } else {
         value = result->value(0).toString();
+        cacheUrn(trackerUrl(url), value);
     }
-
-    delete result;
     return value;
 }
 
@@ -183,9 +298,9 @@ QDateTime TrackerUtils::contentCreatedForUrl(const QUrl& url)
         return dateTime;
     }
 
-    QString resolvedUrl = url.toEncoded();
-    if ( 0 == url.scheme().length() ) {
-        resolvedUrl = resolvedUrl.insert(0, "file://");
+    QString resolvedUrl = trackerUrl(url);
+    if (m_lastAccessedForUrl.contains(resolvedUrl)) {
+        return m_lastAccessedForUrl.value(resolvedUrl);
     }
 
     static QSparqlQuery query("SELECT ?created { ?urn nie:url ?:url .\n"
@@ -193,7 +308,34 @@ QDateTime TrackerUtils::contentCreatedForUrl(const QUrl& url)
     query.bindValue("url", resolvedUrl);
 
     QSparqlResult *result = m_connection->syncExec(query);
+    dateTime = readContentCreated(result, url);
 
+    delete result;
+    return dateTime;
+}
+
+void TrackerUtils::requestContentCreated(const QUrl& url)
+{
+    if (url.isEmpty()) {
+        emit contentCreatedReady(url, QDateTime());
+        return;
+    }
+
+    QString resolvedUrl = trackerUrl(url);
+    if (m_lastAccessedForUrl.contains(resolvedUrl)) {
+        emit contentCreatedReady(url, m_lastAccessedForUrl.value(resolvedUrl));
+        return;
+    }
+
+    static QSparqlQuery query("SELECT ?created { ?urn nie:url ?:url .\n"
+                              "?urn nfo:fileLastAccessed ?created }");
+    query.bindValue("url", resolvedUrl);
+    startRequest(query, ContentCreatedRequest, url, resolvedUrl);
+}
+
+QDateTime TrackerUtils::readContentCreated(QSparqlResult *result, const QUrl &url)
+{
+    QDateTime dateTime;
     if (result->hasError()) {
         qWarning("Could not query URL %s for nfo:fileLastAccessed: %s",
                  url.toString().toAscii().data(),
@@ -205,9 +347,8 @@ QDateTime TrackerUtils::contentCreatedForUrl(const QUrl& url)
                  url.toString().toAscii().data());
     } else {
         dateTime = result->value(0).toDateTime();
+        m_lastAccessedForUrl.insert(trackerUrl(url), dateTime);
     }
-
-    delete result;
     return dateTime;
 }
 
@@ -230,7 +371,33 @@ QSparqlResult * TrackerUtils::doInitialTrackerQuery(bool waitForFinish)
 
 void TrackerUtils::deleteUrl(const QString &url)
 {
-    deleteUrn(TrackerUtils::urnFromUrl(QUrl(url)));
+    deleteUrls(QStringList() << url);
+}
+
+void TrackerUtils::deleteUrls(const QStringList &urls)
+{
+    QStringList values;
+    foreach (const QString &url, urls) {
+        if (url.isEmpty()) {
+            continue;
+        }
+        QString resolvedUrl = trackerUrl(QUrl(url));
+        resolvedUrl.replace('\\', "\\\\").replace('"', "\\\"");
+        values << QString("\"%1\"").arg(resolvedUrl);
+        forgetDocument(url);
+    }
+
+    if (values.isEmpty()) {
+        return;
+    }
+
+    QSparqlQuery query(QString("DELETE { ?urn a rdfs:Resource . } "
+                               "WHERE { ?urn nie:url ?url . FILTER (?url IN (%1)) }").arg(values.join(", ")),
+                       QSparqlQuery::DeleteStatement);
+
+    QSparqlResult *result = m_connection->exec(query);
+    connect(result, SIGNAL(finished()),
+            m_instance.data(), SLOT(deleteResult()));
 }
 
 void TrackerUtils::deleteUrn(const QString &urn)
@@ -245,6 +412,10 @@ void TrackerUtils::deleteUrn(const QString &urn)
     QSparqlResult *result = m_connection->exec(query);
     connect(result, SIGNAL(finished()),
             m_instance.data(), SLOT(deleteResult()));
+
+    if (m_urlForUrn.contains(urn)) {
+        forgetDocument(m_urlForUrn.value(urn));
+    }
 }
 
 DocumentDetails * TrackerUtils::documentDetailsFromUrl(const QString &url)
@@ -254,39 +425,69 @@ DocumentDetails * TrackerUtils::documentDetailsFromUrl(const QString &url)
         return 0;
     }
 
+    if (m_detailsForUrn.contains(urn)) {
+        return new DocumentDetails(m_detailsForUrn.value(urn));
+    }
+
     DocumentDetails *details = 0;
 
-    static QSparqlQuery query("SELECT ?mt ?la ?bs ?add ?sb ?cr ?pub WHERE  { ?:urn a nfo:Document; nie:mimeType ?mt ; "\
-                       "nfo:fileLastAccessed ?la ; nie:byteSize ?bs ; tracker:added ?add ." \
-                       "OPTIONAL {  ?:urn nie:subject ?sb }"   \
-                       "OPTIONAL {  ?:urn nco:creator ?aut ."  \
-                                    "?aut nco:fullname ?cr }"  \
-                       "OPTIONAL {  ?:urn nco:publisher ?nm ." \
-                                    "?nm nco:fullname ?pub }"  \
-                        "}");
+    static QSparqlQuery query(DocumentDetailsQuery);
     query.bindValue("urn", QUrl(urn));
     QSparqlResult *result = m_connection->syncExec(query);
 
+    DocumentDetails value;
+    if (readDocumentDetails(result, url, value)) {
+        m_detailsForUrn.insert(urn, value);
+        details = new DocumentDetails(value);
+    }
+
+    delete result;
+    return details;
+}
+
+void TrackerUtils::requestDocumentDetails(const QString &url)
+{
+    QString resolvedUrl = trackerUrl(QUrl(url));
+    if (!m_urnForUrl.contains(resolvedUrl)) {
+        // Resolve the urn first, the details are queried when it is known
+        static QSparqlQuery urnQuery("SELECT ?urn WHERE { ?urn nie:url ?:url . }");
+        urnQuery.bindValue("url", resolvedUrl);
+        startRequest(urnQuery, DocumentDetailsUrnRequest, QUrl(url), url);
+        return;
+    }
+
+    QString urn = m_urnForUrl.value(resolvedUrl);
+    if (m_detailsForUrn.contains(urn)) {
+        DocumentDetails details(m_detailsForUrn.value(urn));
+        emit documentDetailsReady(url, &details);
+        return;
+    }
+
+    static QSparqlQuery query(DocumentDetailsQuery);
+    query.bindValue("urn", QUrl(urn));
+    startRequest(query, DocumentDetailsRequest, QUrl(url), url);
+}
+
+bool TrackerUtils::readDocumentDetails(QSparqlResult *result, const QString &url, DocumentDetails &details)
+{
     if (result->hasError()) {
         qWarning("Could not query %s for Document details - %s",
                  url.toAscii().data(),
                  result->lastError().message().toAscii().data());
     } else if (!result->first()) {
         qWarning (" %s -- Did not return any data",
-                  query.query().toAscii().data());
+                  result->query().toAscii().data());
     } else {
-        details = new DocumentDetails();
-        details->mimeType = result->binding(0).value().toString();
-        details->lastAccessed = result->binding(1).value().toDateTime();
-        details->size = result->binding(2).value().toDouble();
-        details->created = result->binding(3).value().toDateTime();
-        details->subject = result->binding(4).value().toString();
-        details->author = result->binding(5).value().toString();
-        details->publisher = result->binding(6).value().toString();
+        details.mimeType = result->binding(0).value().toString();
+        details.lastAccessed = result->binding(1).value().toDateTime();
+        details.size = result->binding(2).value().toDouble();
+        details.created = result->binding(3).value().toDateTime();
+        details.subject = result->binding(4).value().toString();
+        details.author = result->binding(5).value().toString();
+        details.publisher = result->binding(6).value().toString();
+        return true;
     }
-
-    delete result;
-    return details;
+    return false;
 }
 
 bool TrackerUtils::isDocumentEncrypted(const QString &url)
@@ -297,12 +498,44 @@ bool TrackerUtils::isDocumentEncrypted(const QString &url)
         resolvedUrl = resolvedUrl.insert(0, "file://");
     }
 
+    QString key = trackerUrl(QUrl(resolvedUrl));
+    if (m_encryptedForUrl.contains(key)) {
+        return m_encryptedForUrl.value(key);
+    }
+
     static QSparqlQuery query("SELECT ?enc { ?urn nie:url ?:url .\n"
                               "?urn nfo:isContentEncrypted ?enc }");
     query.bindValue("url", resolvedUrl);
 
     QSparqlResult *result = m_connection->syncExec(query);
+    value = readEncrypted(result, url, key);
 
+    delete result;
+    return value;
+}
+
+void TrackerUtils::requestEncryptionStatus(const QString &url)
+{
+    QString resolvedUrl = url;
+    if ( !url.startsWith("file://", Qt::CaseInsensitive) ) {
+        resolvedUrl = resolvedUrl.insert(0, "file://");
+    }
+
+    QString key = trackerUrl(QUrl(resolvedUrl));
+    if (m_encryptedForUrl.contains(key)) {
+        emit encryptionStatusReady(url, m_encryptedForUrl.value(key));
+        return;
+    }
+
+    static QSparqlQuery query("SELECT ?enc { ?urn nie:url ?:url .\n"
+                              "?urn nfo:isContentEncrypted ?enc }");
+    query.bindValue("url", resolvedUrl);
+    startRequest(query, EncryptionStatusRequest, QUrl(key), url);
+}
+
+bool TrackerUtils::readEncrypted(QSparqlResult *result, const QString &url, const QString &key)
+{
+    bool value = false;
     if (result->hasError()) {
         qWarning("Could not query Encryption details for %s -- Error Occured %s ",
                  url.toAscii().data(),
@@ -310,15 +543,128 @@ bool TrackerUtils::isDocumentEncrypted(const QString &url)
     } else if (!result->first()) {
         qWarning("Did not find %s in tracker database - %s ",
                  url.toAscii().data(),
-                 query.preparedQueryText().toAscii().data());
+                 result->query().toAscii().data());
     } else {
         value = (result->binding(0).value().isNull())?false:true;
+        m_encryptedForUrl.insert(key, value);
     }
-
-    delete result;
     return value;
 }
 
+void TrackerUtils::startRequest(const QSparqlQuery &query, RequestType type,
+                                const QUrl &url, const QString &key)
+{
+    PendingRequest request;
+    request.type = type;
+    request.url = url;
+    request.key = key;
+
+    QSparqlResult *result = m_connection->exec(query);
+    m_pendingRequests.insert(result, request);
+    connect(result, SIGNAL(finished()),
+            m_instance.data(), SLOT(requestFinished()));
+}
+
+void TrackerUtils::requestFinished()
+{
+    QSparqlResult *result(qobject_cast<QSparqlResult*>(sender()));
+    if (result == 0 || !m_pendingRequests.contains(result))
+        return;
+
+    const PendingRequest request = m_pendingRequests.take(result);
+
+    switch (request.type) {
+    case UrnFromUrlRequest:
+        emit urnFromUrlReady(request.url, readUrn(result, request.url));
+        break;
+    case UrlFromUrnRequest:
+        emit urlFromUrnReady(request.key, readUrl(result, request.key));
+        break;
+    case FavoriteStatusRequest:
+        emit favoriteStatusReady(request.key, readFavorite(result, request.key));
+        break;
+    case FavoriteToggleRequest: {
+        const bool favorite = readFavorite(result, request.key);
+        if (!result->hasError()) {
+            updateFavoriteTag(request.key, !favorite);
+        }
+        break;
+    }
+    case ContentCreatedRequest:
+        emit contentCreatedReady(request.url, readContentCreated(result, request.url));
+        break;
+    case EncryptionStatusRequest:
+        emit encryptionStatusReady(request.key, readEncrypted(result, request.key, trackerUrl(request.url)));
+        break;
+    case DocumentDetailsUrnRequest:
+        if (readUrn(result, request.url).isEmpty()) {
+            emit documentDetailsReady(request.key, 0);
+        } else {
+            requestDocumentDetails(request.key);
+        }
+        break;
+    case DocumentDetailsRequest: {
+        DocumentDetails details;
+        if (readDocumentDetails(result, request.key, details)) {
+            QString urn = m_urnForUrl.value(trackerUrl(request.url));
+            if (!urn.isEmpty()) {
+                m_detailsForUrn.insert(urn, details);
+            }
+            emit documentDetailsReady(request.key, &details);
+        } else {
+            emit documentDetailsReady(request.key, 0);
+        }
+        break;
+    }
+    }
+
+    result->deleteLater();
+}
+
+void TrackerUtils::cacheUrn(const QString &url, const QString &urn)
+{
+    if (url.isEmpty() || urn.isEmpty()) {
+        return;
+    }
+    m_urnForUrl.insert(url, urn);
+    m_urlForUrn.insert(urn, url);
+}
+
+void TrackerUtils::cacheDocument(const QString &url, const QString &urn, const QDateTime &lastAccessed,
+                                 bool favorite, bool encrypted)
+{
+    QString resolvedUrl = trackerUrl(QUrl(url));
+    cacheUrn(resolvedUrl, urn);
+    m_lastAccessedForUrl.insert(resolvedUrl, lastAccessed);
+    m_encryptedForUrl.insert(resolvedUrl, encrypted);
+    cacheFavoriteStatus(urn, favorite);
+
+    if (m_detailsForUrn.contains(urn)) {
+        m_detailsForUrn[urn].lastAccessed = lastAccessed;
+    }
+}
+
+void TrackerUtils::cacheFavoriteStatus(const QString &itemUrn, bool favorite)
+{
+    if (!itemUrn.isEmpty()) {
+        m_favoriteForUrn.insert(itemUrn, favorite);
+    }
+}
+
+void TrackerUtils::forgetDocument(const QString &url)
+{
+    QString resolvedUrl = trackerUrl(QUrl(url));
+    QString urn = m_urnForUrl.take(resolvedUrl);
+
+    m_lastAccessedForUrl.remove(resolvedUrl);
+    m_encryptedForUrl.remove(resolvedUrl);
+    if (!urn.isEmpty()) {
+        m_urlForUrn.remove(urn);
+        m_favoriteForUrn.remove(urn);
+        m_detailsForUrn.remove(urn);
+    }
+}
+
 void TrackerUtils::deleteResult()
 {
     QSparqlResult *result(qobject_cast<QSparqlResult*>(sender()));
@@ -345,11 +691,12 @@ TrackerLiveQuery * TrackerUtils::createTrackerLiveQuery()
 #endif
 
     QString mainQuery("SELECT DISTINCT nie:url(?urn) AS ?url nfo:fileLastAccessed(?urn) AS ?la nie:mimeType(?urn) AS ?mimetype "
-                      "?fav nfo:fileName(?urn) AS ?filename ?urn  tracker:id(?urn) AS ?trackerid WHERE { "
+                      "?fav nfo:fileName(?urn) AS ?filename ?urn  tracker:id(?urn) AS ?trackerid ?enc WHERE { "
                       "{ ?urn a nfo:FileDataObject } { ?urn a nfo:PaginatedTextDocument } UNION { ?urn a nfo:PlainTextDocument } UNION {?urn a nfo:Presentation } "
                       "{ ?urn a nfo:Document ; nfo:fileName ?fn . "
                       "FILTER regex(?fn, \"\\\\.txt$|\\\\.ppt$|\\\\.odp$|\\\\.pptx$|\\\\.pps$|\\\\.ppsx$|\\\\.doc$|\\\\.pdf$|\\\\.xls$|\\\\.docx$|\\\\.odt$|\\\\.xlsx$|\\\\.ods$\", \"i\" ) } "
-                      "OPTIONAL { ?urn nao:hasTag ?fav . FILTER(?fav = nao:predefined-tag-favorite) } ");
+                      "OPTIONAL { ?urn nao:hasTag ?fav . FILTER(?fav = nao:predefined-tag-favorite) } "
+                      "OPTIONAL { ?urn nfo:isContentEncrypted ?enc } ");
 
     QString updateQuery(mainQuery);
     updateQuery += "  %FILTER } ORDER BY ?mimetype";
@@ -357,14 +704,14 @@ TrackerLiveQuery * TrackerUtils::createTrackerLiveQuery()
     mainQuery += " } ORDER BY ?mimetype";
 
     QSparqlQuery mainSparqlQuery(mainQuery);
-    TrackerLiveQuery *liveQuery = new TrackerLiveQuery(mainSparqlQuery, 7, (QList<int>() << 6), *m_connection);
+    TrackerLiveQuery *liveQuery = new TrackerLiveQuery(mainSparqlQuery, 8, (QList<int>() << 6), *m_connection);
 
     liveQuery->setCollationColumns(QList<TrackerLiveQuery::CollationColumn>()
                                   << TrackerLiveQuery::CollationColumn(2, QVariant::String, Qt::AscendingOrder));
 
     TrackerPartialUpdater updater(updateQuery);
     QStringList documentPredicates;
-    documentPredicates << "nfo:fileLastAccessed" << "nao:hasTag" << "rdf:type";
+    documentPredicates << "nfo:fileLastAccessed" << "nao:hasTag" << "rdf:type" << "nfo:isContentEncrypted";
     updater.watchClass("nfo:Document",
                        documentPredicates,
                        "tracker:id(?urn) in %LIST",
@@ -4,15 +4,18 @@
 #define TRACKERUTILS_H
 
 #include <QString>
+#include <QStringList>
 #include <QObject>
+#include <QHash>
+#include <QUrl>
 
 #include "documentlistmodel.h"
 #include <common_export.h>
 
 class QSparqlConnection;
 class QSparqlResult;
+class QSparqlQuery;
 class QDateTime;
-class QUrl;
 class TrackerLiveQuery;
 
 struct DocumentDetails {
@@ -28,6 +31,12 @@ struct DocumentDetails {
 //! \class TrackerUtils
 //! \brief TrackerUtils contains static utility functions for interacting with tracker
 //!
+//! URN <-> URL mappings and per document attributes are kept in an in-memory
+//! cache which is fed by the document live query and by completed lookups.
+//! The request* methods never block: the answer is delivered through the
+//! matching *Ready signal, which is emitted before the call returns when the
+//! value is already cached.
+//!
 class COMMON_EXPORT TrackerUtils: public QObject
 {
     Q_OBJECT
@@ -47,11 +56,20 @@ public:
     //! \param itemUrn Urn to the item that is unmarked as favorite
     void unmarkItemAsFavorite(const QString& itemUrn);
 
+    //! Adds or removes the favorite tag of an item without blocking. An
+    //! uncached favorite state is asked from tracker first.
+    //! \param itemUrn Urn to the item
+    void toggleItemFavorite(const QString& itemUrn);
+
     //! Checks whether item is marked as favorite
     //! \param itemUrn Urn to the item
     //! \return True if item is marked as favorite, otherwise false
     bool isItemMarkedAsFavorite(const QString& itemUrn);
 
+    //! Asynchronous version of isItemMarkedAsFavorite
+    //! \param itemUrn Urn to the item, echoed back in favoriteStatusReady
+    void requestFavoriteStatus(const QString& itemUrn);
+
     //! Updates nie::contentAccessed property in tracker with current date and time
     //! \param itemUrn Urn to the item that is to be updated
     void updateContentAccessedProperty(const QString& itemUrn);
@@ -61,44 +79,139 @@ public:
     //! \return Url of the item
     QUrl urlFromUrn(const QString& urn);
 
+    //! Asynchronous version of urlFromUrn
+    //! \param urn Urn of item, echoed back in urlFromUrnReady
+    void requestUrlFromUrn(const QString& urn);
+
     //! Returns urn from url
     //! \param url Url of item
     //! \return Urn of the item
     QString urnFromUrl(const QUrl& url);
 
+    //! Asynchronous version of urnFromUrl
+    //! \param url Url of item, echoed back in urnFromUrlReady
+    void requestUrnFromUrl(const QUrl& url);
+
     //! Returns the nie:contentCreated property for a given URL
     //! \param url URL of the item
     //! \return Content Created date of the item. QDateTime::isNull is true,
     //!    if the contentCreated property was unavailable.
     QDateTime contentCreatedForUrl(const QUrl& url);
 
+    //! Asynchronous version of contentCreatedForUrl
+    //! \param url URL of the item, echoed back in contentCreatedReady
+    void requestContentCreated(const QUrl& url);
+
     QSparqlResult * doInitialTrackerQuery(bool waitForFinish = false);
 
     void deleteUrn(const QString& urn);
 
     void deleteUrl(const QString& url);
 
+    //! Deletes the resources of all given urls with a single update. The urns
+    //! are resolved by the update itself, so no lookup is needed beforehand.
+    //! \param urls Urls of the items, with or without the file:// scheme
+    void deleteUrls(const QStringList& urls);
+
     DocumentDetails * documentDetailsFromUrl(const QString &url);
 
+    //! Asynchronous version of documentDetailsFromUrl
+    //! \param url Url of item, echoed back in documentDetailsReady
+    void requestDocumentDetails(const QString &url);
+
     bool isDocumentEncrypted(const QString& url);
 
+    //! Asynchronous version of isDocumentEncrypted
+    //! \param url Url of item, echoed back in encryptionStatusReady
+    void requestEncryptionStatus(const QString& url);
+
     TrackerLiveQuery * createTrackerLiveQuery();
 
     TrackerLiveQuery * createDocumentLiveUpdate(const QUrl &url);
 
+    //! Stores a row of the document live query in the cache
+    //! \param url nie:url of the document
+    //! \param urn Urn of the document
+    //! \param lastAccessed nfo:fileLastAccessed of the document
+    //! \param favorite True if the document is tagged as favorite
+    //! \param encrypted True if the document content is encrypted
+    void cacheDocument(const QString &url, const QString &urn, const QDateTime &lastAccessed,
+                       bool favorite, bool encrypted);
+
+    //! Updates the cached favorite state of an item
+    void cacheFavoriteStatus(const QString &itemUrn, bool favorite);
+
+    //! Drops everything cached for the given url
+    void forgetDocument(const QString &url);
+
+Q_SIGNALS:
+    void urnFromUrlReady(const QUrl &url, const QString &urn);
+    void urlFromUrnReady(const QString &urn, const QUrl &url);
+    void favoriteStatusReady(const QString &itemUrn, bool favorite);
+    void contentCreatedReady(const QUrl &url, const QDateTime &created);
+    void encryptionStatusReady(const QString &url, bool encrypted);
+    //! \param details The details, or 0 if they are not available. Only valid
+    //!    during the signal emission.
+    void documentDetailsReady(const QString &url, const DocumentDetails *details);
+
 private Q_SLOTS:
     //! Deletes a QSparqlResult that was left running asynchronously.
     void deleteResult();
 
+    //! Delivers the result of a request* query.
+    void requestFinished();
+
 private:
+    enum RequestType {
+        UrnFromUrlRequest,
+        UrlFromUrnRequest,
+        FavoriteStatusRequest,
+        FavoriteToggleRequest,
+        ContentCreatedRequest,
+        EncryptionStatusRequest,
+        DocumentDetailsUrnRequest,
+        DocumentDetailsRequest
+    };
+
+    struct PendingRequest {
+        RequestType type;
+        QUrl url;
+        QString key;
+    };
+
     static QSharedPointer<TrackerUtils> m_instance;
 
     //! Private defauult constructor, to disallow instantiation.
     TrackerUtils();
 
+    void startRequest(const QSparqlQuery &query, RequestType type,
+                      const QUrl &url, const QString &key);
+
+    QString readUrn(QSparqlResult *result, const QUrl &url);
+    QUrl readUrl(QSparqlResult *result, const QString &urn);
+    bool readFavorite(QSparqlResult *result, const QString &itemUrn);
+    QDateTime readContentCreated(QSparqlResult *result, const QUrl &url);
+    bool readEncrypted(QSparqlResult *result, const QString &url, const QString &key);
+    bool readDocumentDetails(QSparqlResult *result, const QString &url, DocumentDetails &details);
+
+    void cacheUrn(const QString &url, const QString &urn);
+
+    void updateFavoriteTag(const QString &itemUrn, bool favorite);
+
     //! Instance, needed to get signals delivered to the slot above.
     QSparqlConnection *m_connection;
 
+    QHash<QSparqlResult *, PendingRequest> m_pendingRequests;
+
+    //! Caches, keyed by the url as stored in tracker (file://, percent encoded)
+    QHash<QString, QString> m_urnForUrl;
+    QHash<QString, QDateTime> m_lastAccessedForUrl;
+    QHash<QString, bool> m_encryptedForUrl;
+
+    //! Caches, keyed by urn
+    QHash<QString, QString> m_urlForUrn;
+    QHash<QString, bool> m_favoriteForUrn;
+    QHash<QString, DocumentDetails> m_detailsForUrn;
 };
 
 #endif // TRACKERUTILS_H
@@ -72,6 +72,29 @@ const int KofficePageNumberUpdateIntervalTime = 1500;
 const int KofficeScrollAreaReUpdateTimeout    = 500;
 const int MaxThreadWaitTime                   = 1000;
 const int SpreadSheetInitIntervalTime         = 500;
+const int ListPictureViewerLoadDelay          = 3000;
+const int ViewerPreloadDelay                  = 1000;
+const int WindowTypeTimeout                   = 1000;
+const int MaxReadingPositions                 = 100;
+const int MaxCachedDocuments                  = 3;
+const int DeferredContentDelay                = 500;
+const int ThumbnailTimeSlice                  = 30;
+const int ThumbnailLayoutWait                 = 100;
+const int ThumbnailPrefetchWindow             = 2000;
+const int SearchTimeSlice                     = 30;
+const int SlidePrerenderDelay                 = 300;
+const int SlideCacheBudget                    = 12000000;
+const int TvOutSlideCacheBudget               = 48000000;
+const qint64 DocumentCacheBudget              = 40000000;
+const qint64 DocumentPageLayoutCost           = 400000;
+const int ThumbnailCacheBudget                = 20000000;
+const int TileSize                            = 256;
+const int TileCacheBudget                     = 8000000;
+
+/*!
+ * \brief Number of events kept in memory while tracing
+ */
+const int MaxTraceEvents = 200000;
 
 
 /*!
@@ -84,6 +107,8 @@ const qreal ZValuePageIndicator     = 3;
  */
 const int ThumbnailImageWidth               = 350;
 const int PixelsBetweenPages                = 10;
+const int ThumbnailNormalSize               = 128; //! freedesktop.org "normal" thumbnail size
+const int DocumentListIconSize              = 88;
 
 
 /*!
@@ -102,6 +127,8 @@ const QSizeF maxTapAreaSize(50,50);  //! TODO For now the area is big, check if
 
 const QColor highlightColor(255,255,0);
 const QColor highlightColorCurrent(255,127,0);
+//! Opacity of the search highlights drawn over spreadsheet cells
+const int SearchHighlightAlpha = 128;
 
 /*!
  * \brief KOffice specific constants
@@ -0,0 +1,254 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include "canvastilecache.h"
+
+#include <QGraphicsWidget>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QTimer>
+#include <qmath.h>
+
+#include "definitions.h"
+
+CanvasTileCache::CanvasTileCache(QGraphicsWidget *canvasItem)
+    : QGraphicsObject(canvasItem->parentItem())
+    , m_canvasItem(canvasItem)
+    , m_tiles(TileCacheBudget)
+    , m_zoom(0.0)
+    , m_canvasOpacity(1.0)
+    , m_active(false)
+    , m_prefetchPending(false)
+    , m_visibleAreaOnly(false)
+{
+    // below the canvas so that items on top of the canvas stay visible
+    setZValue(canvasItem->zValue() - 1);
+    setAcceptedMouseButtons(Qt::NoButton);
+    hide();
+}
+
+void CanvasTileCache::scrollTo(const QPoint &documentOffset)
+{
+    if (!m_active) {
+        activate();
+        m_direction = QPoint();
+    }
+    else {
+        m_direction = documentOffset - m_documentOffset;
+    }
+    m_documentOffset = documentOffset;
+
+    if (m_size != m_canvasItem->size()) {
+        prepareGeometryChange();
+        m_size = m_canvasItem->size();
+    }
+    setPos(m_canvasItem->pos());
+    update();
+
+    if (!m_prefetchPending) {
+        m_prefetchPending = true;
+        QTimer::singleShot(0, this, SLOT(prefetch()));
+    }
+}
+
+void CanvasTileCache::freeze()
+{
+    // a cached image of the slide is scaled as it is
+    if (!m_canvasItem->isVisible()) {
+        return;
+    }
+
+    deactivate();
+    activate();
+
+    if (m_size != m_canvasItem->size()) {
+        prepareGeometryChange();
+        m_size = m_canvasItem->size();
+    }
+    setPos(m_canvasItem->pos());
+
+    m_snapshot = QPixmap(m_size.toSize());
+    m_snapshot.fill(Qt::transparent);
+    renderCanvas(&m_snapshot, QPoint(0, 0), m_snapshot.rect());
+    update();
+}
+
+void CanvasTileCache::deactivate()
+{
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+    hide();
+    m_snapshot = QPixmap();
+    m_canvasItem->setOpacity(m_canvasOpacity);
+    m_canvasItem->update();
+}
+
+void CanvasTileCache::setVisibleAreaOnly(bool visibleAreaOnly)
+{
+    if (m_visibleAreaOnly != visibleAreaOnly) {
+        m_visibleAreaOnly = visibleAreaOnly;
+        m_tiles.clear();
+    }
+}
+
+void CanvasTileCache::setZoom(qreal zoom)
+{
+    if (!qFuzzyCompare(m_zoom, zoom)) {
+        m_zoom = zoom;
+        m_tiles.clear();
+    }
+}
+
+bool CanvasTileCache::isActive() const
+{
+    return m_active;
+}
+
+void CanvasTileCache::invalidate()
+{
+    m_tiles.clear();
+    update();
+}
+
+QRectF CanvasTileCache::boundingRect() const
+{
+    return QRectF(QPointF(0, 0), m_size);
+}
+
+void CanvasTileCache::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    // the canvas may be replaced by a cached image of the slide
+    if (!m_active || !m_canvasItem->isVisible()) {
+        return;
+    }
+
+    const QRectF exposed = option->exposedRect.intersected(boundingRect());
+
+    if (!m_snapshot.isNull()) {
+        painter->drawPixmap(exposed, m_snapshot, exposed);
+        return;
+    }
+
+    const QRect rect = exposed.toAlignedRect().translated(m_documentOffset);
+
+    painter->save();
+    painter->setClipRect(exposed, Qt::IntersectClip);
+    const int lastColumn = qFloor(qreal(rect.right()) / TileSize);
+    const int lastRow = qFloor(qreal(rect.bottom()) / TileSize);
+    for (int row = qFloor(qreal(rect.top()) / TileSize); row <= lastRow; ++row) {
+        for (int column = qFloor(qreal(rect.left()) / TileSize); column <= lastColumn; ++column) {
+            const QRect tileRect(column * TileSize, row * TileSize, TileSize, TileSize);
+            painter->drawPixmap(tileRect.topLeft() - m_documentOffset, tile(column, row, tileRect & rect)->pixmap);
+        }
+    }
+    painter->restore();
+}
+
+void CanvasTileCache::prefetch()
+{
+    m_prefetchPending = false;
+    if (!m_active || !m_snapshot.isNull() || m_direction.isNull() || !m_canvasItem->isVisible()) {
+        return;
+    }
+
+    // nothing outside of the canvas can be rendered ahead
+    if (m_visibleAreaOnly) {
+        return;
+    }
+
+    // the visible area moved one tile further, only the tiles coming
+    // into view next are not in the cache yet
+    QRect rect = boundingRect().toAlignedRect().translated(m_documentOffset);
+    rect.translate(m_direction.x() > 0 ? TileSize : (m_direction.x() < 0 ? -TileSize : 0),
+                   m_direction.y() > 0 ? TileSize : (m_direction.y() < 0 ? -TileSize : 0));
+    renderTiles(rect);
+}
+
+CanvasTileCache::Tile *CanvasTileCache::tile(int column, int row, const QRect &needed)
+{
+    const qint64 key = (qint64(row) << 32) | quint32(column);
+    const QRect tileRect(column * TileSize, row * TileSize, TileSize, TileSize);
+
+    Tile *entry = m_tiles.object(key);
+    const bool created = !entry;
+    if (created) {
+        entry = new Tile;
+        entry->pixmap = QPixmap(TileSize, TileSize);
+        entry->pixmap.fill(Qt::transparent);
+    }
+
+    // a canvas that only paints what it shows leaves the part of the tile
+    // outside of it empty, that part is rendered once it is scrolled in
+    QRegion missing = QRegion(m_visibleAreaOnly ? needed : tileRect).subtracted(entry->valid);
+    if (m_visibleAreaOnly) {
+        missing &= boundingRect().toAlignedRect().translated(m_documentOffset);
+    }
+
+    // the canvas paints at its own document offset so the tile is asked
+    // for at its place relative to the visible area
+    foreach (const QRect &rect, missing.rects()) {
+        renderCanvas(&entry->pixmap, tileRect.topLeft() - m_documentOffset, rect.translated(-m_documentOffset));
+    }
+    entry->valid += missing;
+    PerfCounters::add(missing.isEmpty() ? PerfCounters::CacheHits : PerfCounters::CacheMisses);
+
+    if (created) {
+        m_tiles.insert(key, entry, TileSize * TileSize * entry->pixmap.depth() / 8);
+    }
+    return entry;
+}
+
+void CanvasTileCache::activate()
+{
+    m_active = true;
+    m_canvasOpacity = m_canvasItem->opacity();
+    m_canvasItem->setOpacity(0.0);
+    show();
+}
+
+void CanvasTileCache::renderCanvas(QPixmap *pixmap, const QPoint &origin, const QRect &exposed)
+{
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = exposed;
+    option.rect = exposed;
+
+    QPainter painter(pixmap);
+    painter.translate(-origin);
+    painter.setClipRect(exposed);
+    m_canvasItem->paint(&painter, &option, 0);
+}
+
+void CanvasTileCache::renderTiles(const QRect &rect)
+{
+    const int lastColumn = qFloor(qreal(rect.right()) / TileSize);
+    const int lastRow = qFloor(qreal(rect.bottom()) / TileSize);
+    for (int row = qFloor(qreal(rect.top()) / TileSize); row <= lastRow; ++row) {
+        for (int column = qFloor(qreal(rect.left()) / TileSize); column <= lastColumn; ++column) {
+            tile(column, row, QRect(column * TileSize, row * TileSize, TileSize, TileSize));
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef CANVASTILECACHE_H
+#define CANVASTILECACHE_H
+
+#include <QGraphicsObject>
+#include <QPixmap>
+#include <QRegion>
+
+#include "perfcounters.h"
+
+/*!
+ * \class CanvasTileCache
+ * \brief Shows an office canvas from cached bitmaps while it is panned or
+ * pinched.
+ *
+ * The tiles are squares of the document at the current zoom, addressed in
+ * document offset coordinates, so a pan step only renders the tiles that
+ * come into view and the rest is blitted. While the cache is active the
+ * canvas is made transparent, which keeps Qt from repainting all of it on
+ * every document offset change, and the tiles are shown below it. The
+ * tiles are kept between pans until the zoom or the content changes.
+ *
+ * During a pinch the visible area is rendered once into a single pixmap
+ * that is scaled together with the page, the real zoom is done when the
+ * pinch is finished.
+ */
+class CanvasTileCache : public QGraphicsObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief The cache is created as a sibling of the canvas item
+     */
+    CanvasTileCache(QGraphicsWidget *canvasItem);
+
+    /*!
+     * \brief Shows the canvas scrolled to given document offset from tiles
+     */
+    void scrollTo(const QPoint &documentOffset);
+
+    /*!
+     * \brief Shows a snapshot of the visible canvas until #deactivate
+     */
+    void freeze();
+
+    /*!
+     * \brief Shows the canvas itself again, the tiles are kept for the next pan
+     */
+    void deactivate();
+
+    /*!
+     * \brief Tells that the canvas paints only what is inside its own
+     * rect, like the spreadsheet canvas that paints only its visible cells.
+     * Tiles of such a canvas are completed as they are scrolled in and
+     * nothing is prefetched.
+     */
+    void setVisibleAreaOnly(bool visibleAreaOnly);
+
+    /*!
+     * \brief Drops the tiles when they were rendered at another zoom
+     */
+    void setZoom(qreal zoom);
+
+    bool isActive() const;
+
+    /*!
+     * \brief Drops the tiles, e.g. when the document size or the shown
+     * content changed
+     */
+    void invalidate();
+
+    QRectF boundingRect() const;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
+
+private slots:
+    /*!
+     * \brief Renders the tiles next to the visible ones in the direction
+     * of the pan
+     */
+    void prefetch();
+
+private:
+    struct Tile {
+        QPixmap pixmap;
+        //! The rendered part in document offset coordinates
+        QRegion valid;
+    };
+
+    void activate();
+    /*!
+     * \brief The tile with at least the needed rect rendered
+     */
+    Tile *tile(int column, int row, const QRect &needed);
+    void renderTiles(const QRect &rect);
+    void renderCanvas(QPixmap *pixmap, const QPoint &origin, const QRect &exposed);
+
+    QGraphicsWidget *m_canvasItem;
+    CountedCache<qint64, Tile> m_tiles;
+    //! The visible area while pinching
+    QPixmap m_snapshot;
+    QPoint m_documentOffset;
+    QSizeF m_size;
+    //! The zoom the tiles are rendered at
+    qreal m_zoom;
+    //! Last pan step, the tiles in that direction are prefetched
+    QPoint m_direction;
+    qreal m_canvasOpacity;
+    bool m_active;
+    bool m_prefetchPending;
+    bool m_visibleAreaOnly;
+};
+
+#endif // CANVASTILECACHE_H
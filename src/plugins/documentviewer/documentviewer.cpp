@@ -4,6 +4,36 @@
 
 #include <QDebug>
 
+#include <poppler-qt4.h>
+
+#ifndef NO_KOFFICE
+#include <KoStore.h>
+#include <kmimetypetrader.h>
+#include <kpluginloader.h>
+#include <kpluginfactory.h>
+#endif
+
+namespace
+{
+    //! The smallest document Poppler opens, used to initialise it
+    const char emptyPdf[] =
+        "%PDF-1.1\n"
+        "1 0 obj << /Type /Catalog /Pages 2 0 R >> endobj\n"
+        "2 0 obj << /Type /Pages /Kids [3 0 R] /Count 1 >> endobj\n"
+        "3 0 obj << /Type /Page /Parent 2 0 R /MediaBox [0 0 1 1] >> endobj\n"
+        "trailer << /Root 1 0 R >>\n"
+        "%%EOF\n";
+
+#ifndef NO_KOFFICE
+    //! One mime type of each part the viewer uses
+    const char * const partMimeTypes[] = {
+        "application/vnd.oasis.opendocument.text",
+        "application/vnd.oasis.opendocument.presentation",
+        "application/vnd.oasis.opendocument.spreadsheet"
+    };
+#endif
+}
+
 DocumentViewer::DocumentViewer()
 {
 }
@@ -36,4 +66,58 @@ DocumentPage *DocumentViewer::createDocumentPage(ApplicationWindow::DocumentType
     return page;
 }
 
+QImage DocumentViewer::documentThumbnail(const QString &filePath, const QSize &size)
+{
+    QImage image;
+#ifndef NO_KOFFICE
+    // Loading the document itself needs the GUI thread, so only the preview
+    // which ODF and OOXML packages carry is used here
+    static const char * const previewNames[] = {
+        "Thumbnails/thumbnail.png",
+        "docProps/thumbnail.jpeg"
+    };
+
+    KoStore *store = KoStore::createStore(filePath, KoStore::Read);
+    if (store && !store->bad()) {
+        for (uint i = 0; i < sizeof(previewNames) / sizeof previewNames[0] && image.isNull(); ++i) {
+            if (store->open(previewNames[i])) {
+                image.loadFromData(store->read(store->size()));
+                store->close();
+            }
+        }
+    }
+    delete store;
+#endif
+    if (!image.isNull()) {
+        image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+void DocumentViewer::preload()
+{
+    qDebug() << __PRETTY_FUNCTION__;
+
+    // Poppler sets up its global parameters and fonts with the first document
+    Poppler::Document *document = Poppler::Document::loadFromData(QByteArray::fromRawData(emptyPdf, sizeof(emptyPdf) - 1));
+    if (document) {
+        delete document->page(0);
+        delete document;
+    }
+
+#ifndef NO_KOFFICE
+    // Loading the part libraries and their factories is what makes the
+    // first office document slow, the factories stay loaded afterwards
+    for (uint i = 0; i < sizeof(partMimeTypes) / sizeof partMimeTypes[0]; ++i) {
+        const KService::List offers = KMimeTypeTrader::self()->query(partMimeTypes[i], QLatin1String("KParts/ReadOnlyPart"));
+        if (!offers.isEmpty()) {
+            KPluginLoader loader(*offers.first());
+            if (!loader.factory()) {
+                qWarning() << __PRETTY_FUNCTION__ << partMimeTypes[i] << loader.errorString();
+            }
+        }
+    }
+#endif
+}
+
 Q_EXPORT_PLUGIN2(office-tools-viewer, DocumentViewer)
@@ -14,6 +14,8 @@ class DOCUMENTVIEWER_EXPORT DocumentViewer : public QObject, public ViewerInterf
 public:
     DocumentViewer();
     DocumentPage *createDocumentPage(ApplicationWindow::DocumentType documentType, const QString &filePath);
+    QImage documentThumbnail(const QString &filePath, const QSize &size);
+    void preload();
 
 };
 
@@ -41,6 +41,7 @@ INCLUDEPATH += /usr/include/KDE/ \
 # Input
 HEADERS += \
     Limits.h \
+    canvastilecache.h \
     officepage.h \
     officeviewer.h \
     officeviewerpresentation.h \
@@ -59,9 +60,11 @@ HEADERS += \
     officefind.h \
     slideanimator.h \
     spreadsheetcommon.h \
+    thumbnailcache.h \
     documentviewer.h
 
 SOURCES += \
+    canvastilecache.cpp \
     officepage.cpp \
     officeviewer.cpp \
     officeviewerpresentation.cpp \
@@ -79,6 +82,7 @@ SOURCES += \
     officefind.cpp \
     slideanimator.cpp \
     spreadsheetcommon.cpp \
+    thumbnailcache.cpp \
     documentviewer.cpp
 
 
@@ -42,12 +42,15 @@
 #include "officeviewerspreadsheet.h"
 #include "officeviewerword.h"
 #include "applicationwindow.h"
+#include "mimetyperegistry.h"
 #include "definitions.h"
 #include "actionpool.h"
 #include "officethumbprovider.h"
 #include "slideanimator.h"
+#include "tracepoint.h"
 
 #include "OfficeInterface.h"
+#include "pluginmanifest.h"
 
 #include <KoProgressUpdater.h>
 #include <KoProgressProxy.h>
@@ -65,6 +68,8 @@ public:
     OfficeThumbProvider provider;
     QString             filePath;
     MProgressIndicator *progressBar;
+    //! Runs from the start of a search until a match is found or the search ends
+    TracePoint         *searchTrace;
 };
 
 class DocumentProgress : public KoProgressProxy
@@ -107,12 +112,14 @@ OfficePagePrivateData::OfficePagePrivateData()
     : officeviewer(0)
     , normalViewPolicy(0)
     , progressBar(0)
+    , searchTrace(0)
 {
 }
 
 OfficePagePrivateData::~OfficePagePrivateData()
 {
     qDebug() << __PRETTY_FUNCTION__;
+    delete searchTrace;
 }
 
 OfficePage::OfficePage(const QString& document)
@@ -166,9 +173,9 @@ void OfficePage::setOpeningProgress(int value)
 
 void OfficePage::loadDocument()
 {
-    QFileInfo fileInfo(documentName);
+    TracePoint trace("loadDocument", "startup");
     //setOpeningProgress(5);
-    switch(ApplicationWindow::checkMimeType(fileInfo.filePath())) {
+    switch(MimeTypeRegistry::viewerType(mimeType)) {
 
     case ApplicationWindow::DOCUMENT_WORD:
         data->officeviewer = new OfficeViewerWord(this);
@@ -207,38 +214,19 @@ void OfficePage::loadDocument()
             data->officeviewer, SLOT(showPage(int)), Qt::QueuedConnection);
     connect(data->officeviewer, SIGNAL(documentLoaded(bool)), this, SLOT(createKoWidget(bool)));
     connect(data->officeviewer, SIGNAL(matchesFound(bool)), this, SLOT(matchesFound(bool)));
+    connect(data->officeviewer, SIGNAL(matchesFound(bool)), this, SLOT(searchFinished()));
     connect(data->officeviewer, SIGNAL(updateZoomLevel(ActionPool::Id)), this, SIGNAL(updateZoomLevel(ActionPool::Id)));
     connect(this, SIGNAL(visibleAreaChanged()), data->officeviewer, SLOT(updateRange()));
+    connect(this, SIGNAL(sceneOrientationChangeFinished(const M::Orientation &)),
+            data->officeviewer, SLOT(orientationChanged()));
 
     DocumentProgress dp(data->progressBar);
-    data->officeviewer->loadDocument(documentName, &dp);
-
-    const QDir pluginDir("/usr/lib/office-tools/plugins");
-    const QStringList plugins = pluginDir.entryList(QDir::Files);
-
-    for (int i = 0; i < plugins.size(); ++i) {
-        QPluginLoader test(pluginDir.absoluteFilePath(plugins.at(i)));
-        QObject *plug = test.instance();
-        if (plug != 0) {
-
-            OfficeInterface* inter = qobject_cast<OfficeInterface*>(plug);
-            if (inter) {
-
-                plug->setParent(this);
-
-                if (inter && inter->pluginType() == "document") { // Other types not supported here
-                    MAction *pluginAction = new MAction(inter->pluginName(), this);
-                    connect(pluginAction, SIGNAL(triggered()), plug, SLOT(emitOpenSignal()));
-                    connect(plug, SIGNAL(openMe(OfficeInterface*)), this, SLOT(openPlugin(OfficeInterface*)));
-                    pluginAction->setLocation(MAction::ApplicationMenuLocation);
-                    addAction(pluginAction);
-                }
-            }
-            else {
-                delete plug;
-            }
-        }
-    }
+    data->officeviewer->loadDocument(documentName, mimeType, &dp);
+}
+
+void OfficePage::addPluginActions()
+{
+    PluginManifest::addActions(this, "document", this, SLOT(openPlugin(OfficeInterface*)));
 }
 
 void OfficePage::openPlugin(OfficeInterface *plugin)
@@ -308,6 +296,9 @@ void OfficePage::searchText(DocumentPage::SearchMode mode, const QString &search
         switch(mode) {
 
         case DocumentPage::SearchFirst:
+            // the viewers search asynchronously, the trace ends in searchFinished
+            delete data->searchTrace;
+            data->searchTrace = new TracePoint("search", "search");
             data->officeviewer->startSearch(searchText);
             break;
 
@@ -322,6 +313,12 @@ void OfficePage::searchText(DocumentPage::SearchMode mode, const QString &search
     }
 }
 
+void OfficePage::searchFinished()
+{
+    delete data->searchTrace;
+    data->searchTrace = 0;
+}
+
 void OfficePage::clearSearchTexts()
 {
     if(data->officeviewer) {
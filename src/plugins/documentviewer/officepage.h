@@ -65,6 +65,12 @@ protected slots:
 
     void openPlugin(OfficeInterface *plugin);
 
+    /*!
+     * \brief Ends the trace of the search when the first match is found or
+     * the search ends without matches
+     */
+    void searchFinished();
+
 protected:
     virtual void showPageIndexInternal(int pageIndex);
 
@@ -72,6 +78,7 @@ protected:
     virtual qreal pinchUpdated(qreal zoomFactor);
     virtual void pinchFinished(const QPointF &center, qreal scale);
     virtual QGraphicsWidget *pinchWidget();
+    virtual void addPluginActions();
 
 private:
     OfficePagePrivateData * const data;
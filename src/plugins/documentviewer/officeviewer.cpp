@@ -44,7 +44,6 @@
 
 //Include Koffice stuff
 #include <KoCanvasController.h>
-#include <KMimeType>
 #include <kmimetypetrader.h>
 #include <kparts/componentfactory.h>
 #include <KoToolManager.h>
@@ -87,13 +86,12 @@ void* OfficeViewer::document()
     return m_document;
 }
 
-void OfficeViewer::loadDocument(const QString &filename, KoProgressProxy *progressProxy)
+void OfficeViewer::loadDocument(const QString &filename, const QString &mimetype, KoProgressProxy *progressProxy)
 {
     if (isLoaded) {
         return;
     }
 
-    QString mimetype = KMimeType::findByPath(filename)->name();
     QString error;
     m_document = KMimeTypeTrader::self()->createPartInstanceFromQuery<KoDocument>(
                      mimetype, 0, 0, QString(),
@@ -51,7 +51,7 @@ public:
     virtual ~OfficeViewer();
 
     void* document();
-    void loadDocument(const QString &filename, KoProgressProxy *progressProxy);
+    void loadDocument(const QString &filename, const QString &mimetype, KoProgressProxy *progressProxy);
 
     static QString docOpenError;
 
@@ -29,6 +29,8 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QTextLayout>
 #include <QPropertyAnimation>
+#include <QTime>
+#include <QGraphicsPixmapItem>
 #include <QtDBus>
 
 //Include M stuff
@@ -74,6 +76,7 @@
 #include "misc.h"
 #include "pannablescrollbars.h"
 #include "officeviewereventfilter.h"
+#include "perfcounters.h"
 
 OfficeViewerPresentation::OfficeViewerPresentation(SlideAnimator *slideAnimator, QGraphicsWidget *parent)
     : OfficeViewer(parent)
@@ -85,7 +88,12 @@ OfficeViewerPresentation::OfficeViewerPresentation(SlideAnimator *slideAnimator,
     , m_pageCount(0)
     , m_lastUserDefinedFactor(1.0)
     , m_searchIndex(0)
+    , m_highlightedPage(-1)
+    , m_searchStartPage(0)
+    , m_searchedPages(0)
     , m_slideAnimator(slideAnimator)
+    , m_slidePixmaps(SlideCacheBudget)
+    , m_slideImage(0)
 {
     setObjectName("officeviewerpresentation");
     m_pannableScrollbars = 0;
@@ -94,9 +102,6 @@ OfficeViewerPresentation::OfficeViewerPresentation(SlideAnimator *slideAnimator,
     m_highlight.setBackground(QBrush(highlightColor));
     m_highlightCurrent.setBackground(QBrush(highlightColorCurrent));
 
-    QObject::connect(ApplicationWindow::GetSceneManager(), SIGNAL(orientationChangeFinished(const M::Orientation &)),
-                     this, SLOT(orientationChanged()));
-
     m_zoomLevel = ZoomLevel(ZoomLevel::FitToWidth, 1.0, false);
 
     m_actionCollection->addAction(KStandardAction::Prior, "page_previous", this, SLOT(goToPreviousPage()));
@@ -114,6 +119,13 @@ OfficeViewerPresentation::OfficeViewerPresentation(SlideAnimator *slideAnimator,
     QObject::connect(m_slideAnimator, SIGNAL(animationNextFinished()), this, SLOT(animationNextFinished()));
     QObject::connect(m_slideAnimator, SIGNAL(animationPreviousFinished()), this, SLOT(animationPreviousFinished()));
     QObject::connect(m_slideAnimator, SIGNAL(animationCanceled()), this, SLOT(animationCanceled()));
+
+    m_prerenderTimer.setSingleShot(true);
+    m_prerenderTimer.setInterval(SlidePrerenderDelay);
+    QObject::connect(&m_prerenderTimer, SIGNAL(timeout()), this, SLOT(prerenderSlides()));
+
+    m_searchTimer.setSingleShot(true);
+    QObject::connect(&m_searchTimer, SIGNAL(timeout()), this, SLOT(searchStep()));
 }
 
 
@@ -184,7 +196,10 @@ void OfficeViewerPresentation::doUpdateActivePage(KoPAPageBase * page)
 
     if(pageChanged) {
         proxyObject->emitActivePageChanged();
+        m_prerenderTimer.start();
     }
+    updateSearchHighlights();
+    updateSlideImage();
 
     QSize sz = m_canvasItem->viewConverter()->documentToView(pageSize).toSize();
 
@@ -236,6 +251,11 @@ void OfficeViewerPresentation::setActivePage(KoPAPageBase * page)
     KoPADocument *doc = qobject_cast<KoPADocument*>(m_document);
 
     m_canvasItem->resourceManager()->setResource(KoCanvasResource::CurrentPage, doc->pageIndex(m_currentPage)+1);
+
+    // the slides usually have the same size, so the zoom does not tell
+    if(m_pannableScrollbars) {
+        m_pannableScrollbars->invalidateTiles();
+    }
 }
 
 KoPAPageBase* OfficeViewerPresentation::activePage() const
@@ -364,6 +384,13 @@ bool OfficeViewerPresentation::createKoWidget()
             this, SLOT(topReached(const QPointF &)));
     connect(m_pannableScrollbars, SIGNAL(bottomReached(const QPointF &)),
             this, SLOT(bottomReached(const QPointF &)));
+    connect(m_pannableScrollbars, SIGNAL(panWidgets(qreal, qreal)),
+            this, SLOT(panSlideImage(qreal, qreal)));
+
+    // the rendered slide is shown on top of the canvas
+    m_slideImage = new QGraphicsPixmapItem(m_pannableScrollbars);
+    m_slideImage->setZValue(1);
+    m_slideImage->setVisible(false);
 
     // Get the canvas
     m_canvasItem = dynamic_cast<KoPACanvasItem*>(document->canvasItem());
@@ -408,6 +435,7 @@ bool OfficeViewerPresentation::createKoWidget()
     zoom(m_zoomLevel);
 
     doUpdateActivePage(m_currentPage);
+    m_prerenderTimer.start();
     return true;
 }
 
@@ -430,6 +458,9 @@ void OfficeViewerPresentation::updateSizes()
 void OfficeViewerPresentation::orientationChanged()
 {
     updateSizes();
+    showLiveCanvas();
+    m_slidePixmaps.clear();
+    m_prerenderTimer.start();
     if (m_zoomController) {
         qreal effectiveZoomFactor = m_zoomController->zoomAction()->effectiveZoom();
         qreal fitToPageZoomFactor = minimumZoomFactor();
@@ -533,6 +564,8 @@ void OfficeViewerPresentation::zoom(const ZoomLevel &newLevel)
             m_lastUserDefinedFactor = zAction->effectiveZoom();
             ActionPool::instance()->setUserDefinedZoomFactor(m_lastUserDefinedFactor);
         }
+
+        updateSlideImage();
     }
 }
 
@@ -653,17 +686,16 @@ void OfficeViewerPresentation::prepareAnimation(const QPointF &lastPosition, KoP
 
     qDebug() << __PRETTY_FUNCTION__;
     QSize size = ApplicationWindow::visibleSize();
-    // TODO make sure the thumbnail is only as big as the page
 
-    KoZoomHandler zoomHandler;
-    const KoPageLayout &layout = newPage->pageLayout();
-    KoPAUtil::setZoom(layout, size, zoomHandler);
-    QRect pageRect(KoPAUtil::pageRect(layout, size, zoomHandler));
-    QPixmap slidePixmap = newPage->thumbnail(pageRect.size());
-    QPixmap pixmap(size);
-    pixmap.fill("#6b6e70");
-    QPainter painter(&pixmap);
-    painter.drawPixmap(pageRect, slidePixmap, slidePixmap.rect());
+    // normally the slide has been rendered in prerenderSlides already
+    QPixmap *cached = m_slidePixmaps.object(newPage);
+    QPixmap pixmap = cached ? *cached : QPixmap();
+    if (pixmap.size() != size) {
+        PerfCounters::add(PerfCounters::CacheMisses);
+        pixmap = slidePixmap(newPage, size);
+    } else {
+        PerfCounters::add(PerfCounters::CacheHits);
+    }
 
     m_slideAnimator->setPixmap(pixmap);
     m_slideAnimator->setDirection(direction);
@@ -704,6 +736,135 @@ void OfficeViewerPresentation::prepareAnimation(const QPointF &lastPosition, KoP
     }
 }
 
+void OfficeViewerPresentation::prerenderSlides()
+{
+    KoPADocument *doc = qobject_cast<KoPADocument*>(m_document);
+    if (!doc || !m_currentPage) {
+        return;
+    }
+
+    // do not get in the way of a running slide animation
+    if (m_slideAnimator->isVisible()) {
+        m_prerenderTimer.start();
+        return;
+    }
+
+    // the highlighted search results would end up in the rendered slides
+    if (!m_searchResults.isEmpty()) {
+        return;
+    }
+
+    const QSize size = ApplicationWindow::visibleSize();
+    KoPAPageBase *slides[] = {
+        m_currentPage,
+        doc->pageByNavigation(m_currentPage, KoPageApp::PageNext),
+        doc->pageByNavigation(m_currentPage, KoPageApp::PagePrevious)
+    };
+
+    // slides rendered earlier stay in the cache until it runs out of space,
+    // so flipping back and forth does not render them again
+    for (unsigned int i = 0; i < sizeof(slides) / sizeof slides[0]; ++i) {
+        if (prerenderSlide(slides[i], size)) {
+            // the other slides in the next idle steps
+            m_prerenderTimer.start();
+            return;
+        }
+    }
+
+    // on TV-out the audience may be shown any slide, so render the rest of
+    // the deck following the active slide as long as it fits into the cache
+    if (!tvoutPluggedIn) {
+        return;
+    }
+
+    const int pageCount = doc->pageCount();
+    const int current = doc->pageIndex(m_currentPage);
+    const int cost = size.width() * size.height() * QPixmap::defaultDepth() / 8;
+    for (int i = 1; i < pageCount && m_slidePixmaps.totalCost() + cost <= m_slidePixmaps.maxCost(); ++i) {
+        if (prerenderSlide(doc->pageByIndex((current + i) % pageCount, false), size)) {
+            m_prerenderTimer.start();
+            return;
+        }
+    }
+}
+
+bool OfficeViewerPresentation::prerenderSlide(KoPAPageBase *page, const QSize &size)
+{
+    QPixmap *cached = m_slidePixmaps.object(page);
+    if (!page || (cached && cached->size() == size)) {
+        return false;
+    }
+
+    QPixmap *pixmap = new QPixmap(slidePixmap(page, size));
+    m_slidePixmaps.insert(page, pixmap, pixmap->width() * pixmap->height() * pixmap->depth() / 8);
+    return true;
+}
+
+QPixmap OfficeViewerPresentation::slidePixmap(KoPAPageBase *page, const QSize &size) const
+{
+    // TODO make sure the thumbnail is only as big as the page
+    KoZoomHandler zoomHandler;
+    const KoPageLayout &layout = page->pageLayout();
+    KoPAUtil::setZoom(layout, size, zoomHandler);
+    QRect pageRect(KoPAUtil::pageRect(layout, size, zoomHandler));
+    QPixmap thumbnail = page->thumbnail(pageRect.size());
+    QPixmap pixmap(size);
+    pixmap.fill("#6b6e70");
+    QPainter painter(&pixmap);
+    painter.drawPixmap(pageRect, thumbnail, thumbnail.rect());
+    return pixmap;
+}
+
+void OfficeViewerPresentation::updateSlideImage()
+{
+    if (!m_slideImage || !m_currentPage) {
+        return;
+    }
+
+    // only the whole slide fit into the screen looks like the rendered one
+    ZoomLevel::Mode mode = m_zoomLevel.getMode();
+    if ((mode != ZoomLevel::FitToPage && mode != ZoomLevel::FitToHeight) || !m_searchResults.isEmpty()) {
+        showLiveCanvas();
+        return;
+    }
+
+    QPixmap *cached = m_slidePixmaps.object(m_currentPage);
+    if (!cached || cached->size() != ApplicationWindow::visibleSize()) {
+        PerfCounters::add(PerfCounters::CacheMisses);
+        showLiveCanvas();
+        return;
+    }
+    PerfCounters::add(PerfCounters::CacheHits);
+
+    m_slideImage->setPixmap(*cached);
+    m_slideImagePosition = m_pannableScrollbars->position();
+    m_slideImage->setPos(0, 0);
+    m_slideImage->setVisible(true);
+    // a hidden canvas does not paint its shapes
+    m_canvasItem->setVisible(false);
+}
+
+void OfficeViewerPresentation::showLiveCanvas()
+{
+    if (!m_slideImage || !m_slideImage->isVisible()) {
+        return;
+    }
+
+    m_canvasItem->setVisible(true);
+    m_slideImage->setVisible(false);
+    m_slideImage->setPixmap(QPixmap());
+}
+
+void OfficeViewerPresentation::panSlideImage(qreal x, qreal y)
+{
+    Q_UNUSED(x);
+    // the slide is fit into the screen so it can only be pulled vertically
+    // to change the slide
+    if (m_slideImage->isVisible()) {
+        m_slideImage->setPos(0, m_slideImagePosition.y() - y);
+    }
+}
+
 void OfficeViewerPresentation::setCurrentPage(int pageIndex)
 {
     if((1 + pageIndex) != m_currentPageNr) {
@@ -751,6 +912,8 @@ void OfficeViewerPresentation::startSearch(const QString & searchString)
 
     m_searchIndex = 0;
     clearSearchResults();
+    // the rendered slides do not show the highlighted search results
+    showLiveCanvas();
 
     if(!m_document || !m_pannableScrollbars || !m_canvasItem) {
         return;
@@ -758,56 +921,62 @@ void OfficeViewerPresentation::startSearch(const QString & searchString)
 
     KoPADocument* padoc = qobject_cast<KoPADocument*>(m_document);
 
-    if(padoc) {
-        // loop over all pages starting from current page to get
-        // search results in the right order
-        int curPage = m_canvasItem->resourceManager()->resource(KoCanvasResource::CurrentPage).toInt()-1;
+    if(!padoc) {
+        emit matchesFound(false);
+        return;
+    }
+
+    // the pages are searched in steps starting from the current page, so
+    // the search results are in the right order and the first one can be
+    // shown as soon as it is found
+    m_searchText = searchString;
+    m_searchStartPage = padoc->pageIndex(m_currentPage);
+    m_searchedPages = 0;
+    m_searchTimer.start();
+}
+
+void OfficeViewerPresentation::searchStep()
+{
+    KoPADocument* padoc = qobject_cast<KoPADocument*>(m_document);
+
+    if(!padoc) {
+        return;
+    }
+
+    const int pageCount = padoc->pageCount();
+    QTime time;
+    time.start();
+
+    while(m_searchedPages < pageCount && time.elapsed() < SearchTimeSlice) {
+        int pageIndex = (m_searchStartPage + m_searchedPages) % pageCount;
+        KoPAPageBase* papage = padoc->pageByIndex(pageIndex, false);
         QList<QPair<KoPAPageBase*, KoShape*> > textShapes;
         QList<QTextDocument*> textDocs;
 
-        for(int page = 0; page < padoc->pageCount(); page++) {
-            KoPAPageBase* papage = padoc->pageByIndex(page, false);
-            findTextShapesRecursive(papage, papage, textShapes, textDocs);
-        };
-
-        findText(textDocs, textShapes, searchString);
-
-        // now find the first search result in the list of positions counting from the current page
-        // this is not very efficient...
-        bool foundIt = false;
-
-        for(int page = curPage; page < padoc->pageCount(); page++) {
-            for(int i = 0; i < m_searchResults.size(); i++) {
-                if(m_searchResults[i].page == padoc->pageByIndex(page, false)) {
-                    foundIt = true;
-                    m_searchIndex = i;
-                    highlightText(m_searchIndex,true);
-                    centerToResult(i);
-                    break;
-                }
-            }
-
-            if(foundIt) break;
-        }
+        findTextShapesRecursive(papage, papage, textShapes, textDocs);
 
-        if(!foundIt) {
-            for(int page = 0; page < curPage; page++) {
-                for(int i = 0; i < m_searchResults.size(); i++) {
-                    if(m_searchResults[i].page == padoc->pageByIndex(page, false)) {
-                        foundIt = true;
-                        m_searchIndex = i;
-                        highlightText(m_searchIndex,true);
-                        centerToResult(i);
-                        break;
-                    }
-                }
+        bool found = !m_searchResults.isEmpty();
+        findText(textDocs, textShapes, pageIndex, m_searchText);
+        ++m_searchedPages;
+        PerfCounters::add(PerfCounters::SearchedPages);
 
-                if(foundIt) break;
-            }
+        if(!found && !m_searchResults.isEmpty()) {
+            // the first search result is shown right away
+            centerToResult(m_searchIndex);
+            emit matchesFound(true);
+        }
+        else if(papage == m_currentPage) {
+            // the user went to a page before it was searched
+            updateSearchHighlights();
         }
     }
 
-    emit matchesFound(m_searchResults.size() > 0);
+    if(m_searchedPages < pageCount) {
+        m_searchTimer.start();
+    }
+    else if(m_searchResults.isEmpty()) {
+        emit matchesFound(false);
+    }
 }
 
 void OfficeViewerPresentation::getCurrentVisiblePages(ThumbProvider *thumbProvider)
@@ -820,6 +989,7 @@ void OfficeViewerPresentation::getCurrentVisiblePages(ThumbProvider *thumbProvid
 
 void OfficeViewerPresentation::pinchStarted(QPointF &center)
 {
+    showLiveCanvas();
     m_pannableScrollbars->pinchStarted();
     QSize size = ApplicationWindow::visibleSize();
 
@@ -880,6 +1050,8 @@ void OfficeViewerPresentation::shortTap(const QPointF &point, QObject *object)
         return;
     }
 
+    showLiveCanvas();
+
     QPointF p(m_canvasItem->mapFromScene(point));
     QPointF currentPos(m_pannableScrollbars->position());
     QPointF documentPoint(m_canvasItem->viewConverter()->viewToDocument(p + currentPos - m_canvasItem->pos()));
@@ -1003,6 +1175,9 @@ void OfficeViewerPresentation::highlightText(int index, bool current)
 
     //then mark contents dirty so it'll get redrawn
     doc->markContentsDirty(m_searchResults[index].startPosition, range.length);
+    if(m_pannableScrollbars) {
+        m_pannableScrollbars->invalidateTiles();
+    }
 }
 
 
@@ -1028,8 +1203,9 @@ void OfficeViewerPresentation::findTextShapesRecursive(KoShapeContainer *con,
 }
 
 
-void OfficeViewerPresentation::findText(QList<QTextDocument*> docs,
-                                        QList<QPair<KoPAPageBase*, KoShape*> > shapes,
+void OfficeViewerPresentation::findText(const QList<QTextDocument*> &docs,
+                                        const QList<QPair<KoPAPageBase*, KoShape*> > &shapes,
+                                        int pageIndex,
                                         const QString &text)
 {
     if(docs.isEmpty()) {
@@ -1051,8 +1227,9 @@ void OfficeViewerPresentation::findText(QList<QTextDocument*> docs,
                 pos.shape = shape;
                 pos.startPosition = result.selectionStart();
                 pos.length = result.selectionEnd() - result.selectionStart();
+                m_searchHitsByPage[pageIndex].append(m_searchResults.size());
                 m_searchResults<<pos;
-                highlightText(m_searchResults.size()-1,false);
+                PerfCounters::add(PerfCounters::SearchHits);
             }
         } while(!result.isNull());
     }
@@ -1061,16 +1238,13 @@ void OfficeViewerPresentation::findText(QList<QTextDocument*> docs,
 void OfficeViewerPresentation::previousWord()
 {
     if(searchResultCount() > 0) {
-        highlightText(m_searchIndex,false);
-
         if(m_searchIndex == 0) {
             m_searchIndex = searchResultCount() - 1;
         } else {
             m_searchIndex--;
         }
 
-        highlightText(m_searchIndex,true);
-
+        // moves the highlights along
         centerToResult(m_searchIndex);
     }
 }
@@ -1078,16 +1252,13 @@ void OfficeViewerPresentation::previousWord()
 void OfficeViewerPresentation::nextWord()
 {
     if(searchResultCount() > 0) {
-        highlightText(m_searchIndex,false);
-
         if(m_searchIndex == searchResultCount() - 1) {
             m_searchIndex = 0;
         } else {
             m_searchIndex++;
         }
 
-        highlightText(m_searchIndex,true);
-
+        // moves the highlights along
         centerToResult(m_searchIndex);
     }
 }
@@ -1099,58 +1270,91 @@ int OfficeViewerPresentation::searchResultCount()
 
 void OfficeViewerPresentation::clearSearchResults()
 {
-    bool updated = false;
-    for(int i= 0; i<m_searchResults.size(); i++) {
+    m_searchTimer.stop();
 
-        KoShape *shape = m_searchResults[i].shape;
+    // only the search results on the active slide are highlighted
+    foreach(int index, m_searchHitsByPage.value(m_highlightedPage)) {
+        unhighlightText(index);
+    }
 
-        if(!shape) {
-            continue;
-        }
+    // the rendered slides may show the highlights
+    if (!m_searchResults.isEmpty()) {
+        m_slidePixmaps.clear();
+        m_prerenderTimer.start();
+    }
+    m_searchResults.clear();
+    m_searchHitsByPage.clear();
+    m_highlightedPage = -1;
+}
 
-        KoTextShapeData* tsd = qobject_cast<KoTextShapeData*> (shape->userData());
+void OfficeViewerPresentation::unhighlightText(int index)
+{
+    if(index < 0 || index >= m_searchResults.size()) {
+        return;
+    }
 
-        if(!tsd || !tsd->document()) {
-            continue;
-        }
+    KoShape *shape = m_searchResults[index].shape;
 
-        //Get QTextDocument from text shape's userdata
-        QTextDocument *doc = tsd->document();
+    if(!shape) {
+        return;
+    }
 
-        QTextBlock block = doc->findBlock(m_searchResults[i].startPosition);
+    KoTextShapeData* tsd = qobject_cast<KoTextShapeData*> (shape->userData());
 
-        QTextLayout *layout = block.layout();
+    if(!tsd || !tsd->document()) {
+        return;
+    }
 
-        if(!layout) {
-            continue;
-        }
+    //Get QTextDocument from text shape's userdata
+    QTextDocument *doc = tsd->document();
 
-        //Get the list of all additional formats in the search result's range
-        QList<QTextLayout::FormatRange> ranges = block.layout()->additionalFormats();
+    QTextBlock block = doc->findBlock(m_searchResults[index].startPosition);
 
-        QList<QTextLayout::FormatRange> newRanges;
+    QTextLayout *layout = block.layout();
 
-        //And remove our highlight formatting from the list
-        foreach(QTextLayout::FormatRange range, ranges) {
-            if(range.format != m_highlight && range.format != m_highlightCurrent) {
-                newRanges<<range;
-            }
-        }
+    if(!layout) {
+        return;
+    }
+
+    //Get the list of all additional formats in the search result's range
+    QList<QTextLayout::FormatRange> ranges = layout->additionalFormats();
 
-        //And set the list back
-        if(ranges.count() != newRanges.count()) {
-            block.layout()->setAdditionalFormats(newRanges);
+    QList<QTextLayout::FormatRange> newRanges;
+
+    //And remove our highlight formatting from the list
+    foreach(QTextLayout::FormatRange range, ranges) {
+        if(range.format != m_highlight && range.format != m_highlightCurrent) {
+            newRanges<<range;
         }
+    }
 
-        // update the page so that the search results are no longer visible
-        if (!updated && m_currentPage == m_searchResults[i].page) {
-            m_searchResults[i].page->update();
-            updated = true;
+    //And set the list back
+    if(ranges.count() != newRanges.count()) {
+        layout->setAdditionalFormats(newRanges);
+        doc->markContentsDirty(m_searchResults[index].startPosition, m_searchResults[index].length);
+        if(m_pannableScrollbars) {
+            m_pannableScrollbars->invalidateTiles();
         }
     }
+}
 
-    m_searchResults.clear();
+void OfficeViewerPresentation::updateSearchHighlights()
+{
+    KoPADocument* padoc = qobject_cast<KoPADocument*>(m_document);
 
+    if(!padoc || !m_currentPage || m_searchResults.isEmpty()) {
+        return;
+    }
+
+    foreach(int index, m_searchHitsByPage.value(m_highlightedPage)) {
+        unhighlightText(index);
+    }
+
+    m_highlightedPage = padoc->pageIndex(m_currentPage);
+
+    foreach(int index, m_searchHitsByPage.value(m_highlightedPage)) {
+        highlightText(index, index == m_searchIndex);
+    }
 }
 
 void OfficeViewerPresentation::activeToolChanged(KoCanvasController* canvas, int uniqueToolId)
@@ -1181,12 +1385,19 @@ void OfficeViewerPresentation::tvoutConnected()
                                                                          MCE_REQUEST_IF, MCE_PREVENT_BLANK_REQ));
         tvoutPluggedIn = true;
         preventBlankTimer.start();
+        // room for the whole deck, rendered by prerenderSlides
+        m_slidePixmaps.setMaxCost(TvOutSlideCacheBudget);
     } else {
         tvoutPluggedIn = false;
         preventBlankTimer.stop();
+        m_slidePixmaps.setMaxCost(SlideCacheBudget);
         QDBusConnection::systemBus().call(QDBusMessage::createMethodCall(MCE_SERVICE, MCE_REQUEST_PATH,
                                                                          MCE_REQUEST_IF, MCE_CANCEL_PREVENT_BLANK_REQ));
     }
+
+    if (m_currentPage) {
+        m_prerenderTimer.start();
+    }
 }
 
 void OfficeViewerPresentation::preventBlanking()
@@ -30,13 +30,18 @@
 
 #include <QTextCharFormat>
 #include <QTimer>
+#include <QHash>
+#include <QPixmap>
 
 #include <kactioncollection.h>
 #include <KoPAViewBase.h>
 #include <KoPADocument.h>
 #include "documentviewer_export.h"
+#include "perfcounters.h"
 class QTextDocument;
 
+class QGraphicsPixmapItem;
+
 class KoDocument;
 
 class KoView;
@@ -183,6 +188,24 @@ private slots:
     void animateSlideTop();
     void animateSlideBottom();
 
+    /*!
+     * \brief Renders the active slide and the ones next to it, and the whole
+     * deck while TV-out is connected, one slide per call
+     */
+    void prerenderSlides();
+
+    /*!
+     * \brief Moves the rendered slide along while the view is pulled to
+     * change the slide
+     */
+    void panSlideImage(qreal x, qreal y);
+
+    /*!
+     * \brief Searches the next pages for the search text until the time
+     * slice is used up
+     */
+    void searchStep();
+
 private:
 
     /*!
@@ -220,15 +243,16 @@ private:
                                         QList<QTextDocument*>& docs);
 
     /**
-    * \brief Find specified text from a list of QTextDocuments
+    * \brief Find specified text from a list of QTextDocuments of one page
     *
     * \param docs Found QTextDocument list
     * \param shapes Pages and shapes that contained the QTextDocuments
+    * \param pageIndex Index of the page the shapes are on
     * \param text Text to search for
-    * \return
     */
-    void findText(QList<QTextDocument*> docs,
-                  QList<QPair<KoPAPageBase*, KoShape*> > shapes,
+    void findText(const QList<QTextDocument*> &docs,
+                  const QList<QPair<KoPAPageBase*, KoShape*> > &shapes,
+                  int pageIndex,
                   const QString &text);
 
     /*!
@@ -240,6 +264,17 @@ private:
     */
     void highlightText(int index, bool current);
 
+    /*!
+    * \brief Remove the highlight of a search result
+    * \param index Index of the search result
+    */
+    void unhighlightText(int index);
+
+    /*!
+    * \brief Moves the highlights to the search results on the active slide
+    */
+    void updateSearchHighlights();
+
     /*!
     * \brief Return the amount of search results we have found
     * \return amount of search results found
@@ -255,6 +290,31 @@ private:
      */
     qreal minimumZoomFactor() const;
 
+    /*!
+     * \brief Renders a slide fit into the screen as the slide animation
+     * shows it
+     * \param page is the slide
+     * \param size is the visible size of the screen
+     */
+    QPixmap slidePixmap(KoPAPageBase *page, const QSize &size) const;
+
+    /*!
+     * \brief Renders a slide into the slide cache unless it is there already
+     * \return true if the slide was rendered
+     */
+    bool prerenderSlide(KoPAPageBase *page, const QSize &size);
+
+    /*!
+     * \brief Shows the rendered active slide instead of the canvas if the
+     * slide is fit into the screen and has been rendered already
+     */
+    void updateSlideImage();
+
+    /*!
+     * \brief Replaces the rendered slide with the canvas painting the shapes
+     */
+    void showLiveCanvas();
+
 private:
     KoPACanvasItem *m_canvasItem;
 
@@ -270,6 +330,14 @@ private:
     qreal m_minimumZoomFactor;
     QList<SearchResult> m_searchResults;
     int m_searchIndex;
+    //! Indexes into m_searchResults by the index of the page they are on
+    QHash<int, QList<int> > m_searchHitsByPage;
+    //! The page whose search results are highlighted
+    int m_highlightedPage;
+    QString m_searchText;
+    int m_searchStartPage;
+    int m_searchedPages;
+    QTimer m_searchTimer;
     QTextCharFormat m_highlight;
     QTextCharFormat m_highlightCurrent;
     ContextProperty *tvout;
@@ -278,6 +346,12 @@ private:
     QPoint m_translatedPoint;
     SlideAnimator *m_slideAnimator;
     QPointF m_slideOffset; // this is needed for zoomed sides so that the animation is correct
+    //! Slides fit into the screen, used for the slide animation and shown
+    //! instead of the canvas until the user interacts with the slide
+    CountedCache<KoPAPageBase *, QPixmap> m_slidePixmaps;
+    QTimer m_prerenderTimer;
+    QGraphicsPixmapItem *m_slideImage;
+    QPointF m_slideImagePosition;
 };
 
 #endif // OFFICEVIEWERPRESENTATION_H
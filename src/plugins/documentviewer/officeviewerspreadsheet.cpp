@@ -26,6 +26,7 @@
 #include <QGraphicsItem>
 #include <QDebug>
 #include <QGraphicsSceneMouseEvent>
+#include <QTimer>
 
 //Include M stuff
 #include <MApplication>
@@ -53,6 +54,7 @@
 #include <tables/PrintSettings.h>
 #include <tables/ui/SheetView.h>
 #include <tables/part/ToolRegistry.h>
+#include <tables/Damages.h>
 
 //Include application stuff
 #include "officeviewerspreadsheet.h"
@@ -119,9 +121,10 @@ class OfficeViewerSpreadsheet::Private
 {
 
 public:
-    Private()
+    Private(ThumbnailRenderer *thumbnailRenderer)
         : pannableScrollbars(0)
         , search(0)
+        , searchOverlay(0)
         , utils(0)
         , canvasItem(0)
         , rowHeader(0)
@@ -130,11 +133,13 @@ public:
         , hideIndicatorsLayout(0)
         , rootWidget(0)
         , label(0) // used for making the pan area smaller when quick viewer is visible 
+        , thumbnails(thumbnailRenderer)
     {
     }
 
     SpreadsheetPannableScrollBars *pannableScrollbars;
     SpreadsheetSearch             *search;
+    SpreadsheetSearchOverlay      *searchOverlay;
     SpreadsheetUtils              *utils;
     Calligra::Tables::CanvasItem           *canvasItem;
     Calligra::Tables::RowHeaderItem        *rowHeader;
@@ -144,11 +149,12 @@ public:
     QGraphicsWidget               *rootWidget;
     QSizeF                         unscaledDocSize;
     MLabel *label;
+    ThumbnailCache                 thumbnails;
 };
 
 OfficeViewerSpreadsheet::OfficeViewerSpreadsheet(QGraphicsWidget *parent)
     : OfficeViewer(parent)
-    , d(new Private())
+    , d(new Private(this))
     , currentPage(0)
     , m_lastpageCount(0)
     , lastUserDefinedFactor(1.0)
@@ -164,8 +170,7 @@ OfficeViewerSpreadsheet::OfficeViewerSpreadsheet(QGraphicsWidget *parent)
 
     connectActions();
 
-    connect(ApplicationWindow::GetSceneManager(), SIGNAL(orientationChangeFinished(const M::Orientation &)),
-            this, SLOT(orientationChanged()));
+    connect(&d->thumbnails, SIGNAL(thumbnailReady(int)), this, SIGNAL(thumbnailReady(int)));
 }
 
 OfficeViewerSpreadsheet::~OfficeViewerSpreadsheet()
@@ -253,6 +258,8 @@ bool OfficeViewerSpreadsheet::createKoWidget()
             this, SLOT(setDocumentOffset(QPoint)));
     connect(d->canvasItem, SIGNAL(obscuredRangeChanged(const Calligra::Tables::Sheet*,QSize)),
             this, SLOT(updateObscuredRange(const Calligra::Tables::Sheet*)));
+    connect(spreadDoc->map(), SIGNAL(damagesFlushed(const QList<Damage*>&)),
+            this, SLOT(sheetsDamaged(const QList<Damage*>&)));
 
     int slideCount = pageCount();
 
@@ -273,6 +280,7 @@ bool OfficeViewerSpreadsheet::createKoWidget()
     Q_CHECK_PTR(d->search);
     connect(d->search, SIGNAL(setResults(int, int)), this, SLOT(setSearchResults(int, int)));//, Qt::DirectConnection);
     connect(d->search, SIGNAL(searchFinished()), this, SLOT(searchFinished()));
+    d->searchOverlay = new SpreadsheetSearchOverlay(d->canvasItem);
 
     Calligra::Tables::ToolRegistry::instance()->loadTools();
 
@@ -330,6 +338,9 @@ void OfficeViewerSpreadsheet::updateSizes()
         QPointF position = d->pannableScrollbars->position();
         d->pannableScrollbars->updateRange();
         d->pannableScrollbars->setPosition(position);
+
+        // the canvas size or the zoom may have changed
+        updateSearchOverlay();
     }
 
     if(d->rootWidget) {
@@ -478,6 +489,8 @@ void OfficeViewerSpreadsheet::showPage(int pageIndex)
 
         Calligra::Tables::Sheet* sheet = spreadDoc->map()->sheet(pageIndex);
         d->canvasItem->setActiveSheet(sheet);
+        // the sheets may have the same size
+        d->pannableScrollbars->invalidateTiles();
         d->pannableScrollbars->restoreStartPoint();
         zoom(ZoomLevel(ZoomLevel::FactorMode, d->canvasItem->zoomHandler()->zoom()));
 
@@ -578,6 +591,9 @@ void OfficeViewerSpreadsheet::setDocumentOffset(const QPoint &point)
     }
 
     d->canvasItem->setDocumentOffset(p);
+    if (d->searchOverlay) {
+        d->searchOverlay->update();
+    }
 }
 
 static void paintContent(QPainter& painter, const QRect& rect, Calligra::Tables::Sheet* sheet)
@@ -614,21 +630,74 @@ static void paintContent(QPainter& painter, const QRect& rect, Calligra::Tables:
 }
 
 QImage * OfficeViewerSpreadsheet::getThumbnail(int page)
+{
+    QImage image = d->thumbnails.renderedThumbnail(page);
+    if (image.isNull()) {
+        return 0;
+    }
+    return new QImage(image);
+}
+
+QImage OfficeViewerSpreadsheet::thumbnail(int page)
+{
+    return d->thumbnails.thumbnail(page);
+}
+
+int OfficeViewerSpreadsheet::thumbnailCount()
+{
+    return pageCount();
+}
+
+bool OfficeViewerSpreadsheet::canRenderThumbnails()
+{
+    return true;
+}
+
+QImage OfficeViewerSpreadsheet::renderThumbnail(int sheetIndex)
 {
     Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
 
     if(0 != spreadDoc && 0 != spreadDoc->map()) {
-        Calligra::Tables::Sheet *sheet = spreadDoc->map()->sheet(page);
-
-        QPixmap pix((int)ThumbnailImageWidth, (int)ThumbnailImageWidth);
-        pix.fill(QColor(245, 245, 245));
-        QRect rc(0, 0, pix.width(), pix.height());
-        QPainter p(&pix);
-        paintContent(p, rc, sheet);
-        return (new QImage(pix.toImage()));
+        Calligra::Tables::Sheet *sheet = spreadDoc->map()->sheet(sheetIndex);
+
+        if(sheet) {
+            QImage image((int)ThumbnailImageWidth, (int)ThumbnailImageWidth, QImage::Format_RGB32);
+            image.fill(QColor(245, 245, 245).rgb());
+            QRect rc(0, 0, image.width(), image.height());
+            QPainter p(&image);
+            paintContent(p, rc, sheet);
+            p.end();
+            // 16 bit images take half the room in the cache
+            return image.convertToFormat(QImage::Format_RGB16);
+        }
     }
 
-    return 0;
+    return QImage();
+}
+
+void OfficeViewerSpreadsheet::sheetsDamaged(const QList<Damage*> &damages)
+{
+    Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
+
+    if(!spreadDoc) {
+        return;
+    }
+
+    foreach(Calligra::Tables::Damage *damage, damages) {
+        Calligra::Tables::Sheet *sheet = 0;
+
+        if(damage->type() == Calligra::Tables::Damage::Cell) {
+            sheet = static_cast<Calligra::Tables::CellDamage*>(damage)->sheet();
+        }
+        else if(damage->type() == Calligra::Tables::Damage::Sheet) {
+            sheet = static_cast<Calligra::Tables::SheetDamage*>(damage)->sheet();
+        }
+
+        if(sheet) {
+            const int sheetIndex = spreadDoc->map()->indexOf(sheet);
+            d->thumbnails.remove(sheetIndex);
+        }
+    }
 }
 
 void OfficeViewerSpreadsheet::getCurrentVisiblePages(ThumbProvider *thumbProvider)
@@ -741,9 +810,7 @@ void OfficeViewerSpreadsheet::connectActions()
     };
 
     for(unsigned int i = 0; i < (sizeof(actionData) / sizeof actionData[0]); i++) {
-        MAction *action = actions->getAction(actionData[i].id);
-        Q_CHECK_PTR(action);
-        connect(action, SIGNAL(triggered()), actionData[i].object, actionData[i].slot);
+        actions->connectAction(actionData[i].id, actionData[i].object, actionData[i].slot, this);
     }
 }
 
@@ -857,19 +924,14 @@ void OfficeViewerSpreadsheet::clearSearchResults()
     currentSearchResult.count       = -1;
     currentSearchResult.searchIndex = -1;
 
+    // stops a running search too
+    if (d->search) {
+        d->search->clearResults();
+    }
+
     if (searchResults.size() > 0) {
         searchResults.clear();
-        Calligra::Tables::Sheet *currentSheet = d->canvasItem->activeSheet();
-
-        if(currentSheet) {
-            Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
-            int currentSheetIndex = spreadDoc->map()->indexOf(currentSheet);
-            d->search->clearResults(currentSheetIndex);
-        }
-
-        d->canvasItem->refreshSheetViews();
-
-        d->canvasItem->update();
+        d->searchOverlay->clear();
     }
 }
 
@@ -881,10 +943,6 @@ void OfficeViewerSpreadsheet::startSearch(const QString & searchString)
     clearSearchResults();
 
     if(false == searchString.isEmpty()) {
-        if(d->search->isRunning()) {
-            d->search->exit();
-        }
-
         Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
 
         Calligra::Tables::Sheet *currentSheet = d->canvasItem->activeSheet();
@@ -928,15 +986,6 @@ void OfficeViewerSpreadsheet::nextWord()
             showPage(currentSearchResult.sheetIndex);
         }
 
-        Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
-
-        Calligra::Tables::Sheet* currentSheet = spreadDoc->map()->sheet(currentSearchResult.sheetIndex);
-
-        //d->search->highlightSheetResult(currentSheet, currentSearchResult.sheetIndex, currentSearchResult.count);
-        d->search->setWordsColor(currentSheet, currentSearchResult.sheetIndex, currentSearchResult.count);
-        d->canvasItem->refreshSheetViews();
-        d->canvasItem->update();
-
         showCurrentSearchResult();
     }
 }
@@ -966,15 +1015,6 @@ void OfficeViewerSpreadsheet::previousWord()
             showPage(currentSearchResult.sheetIndex);
         }
 
-        Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
-
-        Calligra::Tables::Sheet* currentSheet = spreadDoc->map()->sheet(currentSearchResult.sheetIndex);
-
-        //d->search->highlightSheetResult(currentSheet, currentSearchResult.sheetIndex, currentSearchResult.count);
-        d->search->setWordsColor(currentSheet, currentSearchResult.sheetIndex, currentSearchResult.count);
-        d->canvasItem->refreshSheetViews();
-        d->canvasItem->update();
-
         showCurrentSearchResult();
 
 
@@ -999,9 +1039,26 @@ void OfficeViewerSpreadsheet::showCurrentSearchResult()
         d->pannableScrollbars->ensureVisible(rect);
     }
 
-    d->canvasItem->refreshSheetViews();
+    updateSearchOverlay();
+}
 
-    d->canvasItem->update();
+void OfficeViewerSpreadsheet::updateSearchOverlay()
+{
+    if(!d->searchOverlay) {
+        return;
+    }
+
+    Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
+    Calligra::Tables::Sheet *currentSheet = d->canvasItem->activeSheet();
+
+    if(!spreadDoc || !currentSheet || searchResults.isEmpty()) {
+        d->searchOverlay->clear();
+        return;
+    }
+
+    int currentSheetIndex = spreadDoc->map()->indexOf(currentSheet);
+    int currentIndex = currentSearchResult.sheetIndex == currentSheetIndex ? currentSearchResult.count : -1;
+    d->searchOverlay->setResults(currentSheet, d->search->sheetResults(currentSheetIndex), currentIndex);
 }
 
 void OfficeViewerSpreadsheet::centerToResult(int index)
@@ -1070,7 +1127,6 @@ void OfficeViewerSpreadsheet::setSearchResults(int index, int count)
 {
     qDebug()<<"setSearchResults index"<<index<<"count"<<count;
     Calligra::Tables::Doc *spreadDoc = qobject_cast<Calligra::Tables::Doc*> (m_document);
-    Calligra::Tables::Sheet* sheet = spreadDoc->map()->sheet(index);
 
     SpreadSheetResult res;
     res.sheetIndex = index;
@@ -1084,10 +1140,6 @@ void OfficeViewerSpreadsheet::setSearchResults(int index, int count)
         currentSearchResult.searchIndex = 0;
         currentSearchResult.count = 0; //Note we are using count as current indexs
 
-        //Let make thread to sleep .3 second
-        d->search->highlightSheetResult(sheet, currentSearchResult.sheetIndex, currentSearchResult.count);
-        d->search->mSleep(300);
-
         //IF result on different shhet show that sheet.
         Calligra::Tables::Sheet *currentSheet = d->canvasItem->activeSheet();
         int currentSheetIndex = 0;
@@ -1102,6 +1154,9 @@ void OfficeViewerSpreadsheet::setSearchResults(int index, int count)
 
         showCurrentSearchResult();
     }
+    else if(d->canvasItem->activeSheet() == spreadDoc->map()->sheet(index)) {
+        updateSearchOverlay();
+    }
 }
 
 void OfficeViewerSpreadsheet::searchFinished()
@@ -1109,10 +1164,6 @@ void OfficeViewerSpreadsheet::searchFinished()
     qDebug()<< __PRETTY_FUNCTION__;
 
     emit matchesFound(searchResults.size() > 0);
-
-    if(d->search->isRunning()) {
-        d->search->exit();
-    }
 }
 
 
@@ -29,6 +29,7 @@
 #include "searchresult.h"
 #include "pannablescrollbars.h"
 #include "documentviewer_export.h"
+#include "thumbnailcache.h"
 class QTextDocument;
 
 class KoDocument;
@@ -49,6 +50,8 @@ class Cell;
 class Sheet;
 
 class CanvasItem;
+
+class Damage;
 }
 }
 
@@ -73,10 +76,13 @@ typedef struct {
  * it own koffice view.
  */
 
-class DOCUMENTVIEWER_EXPORT OfficeViewerSpreadsheet : public OfficeViewer
+class DOCUMENTVIEWER_EXPORT OfficeViewerSpreadsheet : public OfficeViewer, public ThumbnailRenderer
 {
     Q_OBJECT
 
+    // the slot connected to Map::damagesFlushed needs the same spelling
+    typedef Calligra::Tables::Damage Damage;
+
 public:
 
     OfficeViewerSpreadsheet(QGraphicsWidget *parent = 0);
@@ -139,6 +145,16 @@ public:
 
     QImage * getThumbnail(int page);
 
+    /*!
+     * \brief Gets a sheet thumbnail from the thumbnail cache without blocking
+     */
+    virtual QImage thumbnail(int page);
+
+    // ThumbnailRenderer implementation
+    virtual int thumbnailCount();
+    virtual bool canRenderThumbnails();
+    virtual QImage renderThumbnail(int sheetIndex);
+
     virtual int pageCount();
 
     /*!
@@ -262,6 +278,11 @@ protected slots:
      * the actual contents of the sheet might take.
      */
     void updateObscuredRange(const Calligra::Tables::Sheet* sheet);
+
+    /*!
+     * \brief Drops the thumbnails of the sheets that have changed
+     */
+    void sheetsDamaged(const QList<Damage*> &damages);
 protected:
 
     /*!
@@ -287,6 +308,11 @@ protected:
      */
     void showCurrentSearchResult();
 
+    /*!
+     * \brief Shows the search results of the active sheet in the overlay
+     */
+    void updateSearchOverlay();
+
     /*!
      * \brief Scrolls the viewport to given point.
      */
@@ -31,6 +31,7 @@
 #include <QScrollBar>
 #include <QAction>
 #include <QGraphicsSceneMouseEvent>
+#include <QTimer>
 
 //Include M stuff
 #include <MBanner>
@@ -73,6 +74,7 @@ OfficeViewerWord::OfficeViewerWord(QGraphicsWidget *parent)
     , m_pageCount(0)
     , m_lastUserDefinedFactor(1.0)
     , m_thumbnailView(0)
+    , m_thumbnails(this)
 {
     setObjectName("officeviewerword");
     m_pannableScrollbars = NULL;
@@ -86,15 +88,15 @@ OfficeViewerWord::OfficeViewerWord(QGraphicsWidget *parent)
     currentMatchFormat.setBackground(QBrush(highlightColorCurrent));
     KoFindText::setFormat(KoFindText::CurrentMatchFormat, currentMatchFormat);
 
-    QObject::connect(ApplicationWindow::GetSceneManager(), SIGNAL(orientationChangeFinished(const M::Orientation &)),
-                     this, SLOT(orientationChanged()));
-
     m_zoomLevel = ZoomLevel(ZoomLevel::FitToWidth, 1.0, false);
 
+    connect(&m_thumbnails, SIGNAL(thumbnailReady(int)), this, SIGNAL(thumbnailReady(int)));
 }
 
 OfficeViewerWord::~OfficeViewerWord()
 {
+    m_thumbnails.stop();
+
     if (m_thumbnailView) {
         m_document->removeView(m_thumbnailView);
         delete m_thumbnailView;
@@ -350,6 +352,9 @@ void OfficeViewerWord::startSearch(const QString & searchString)
     }
 
     m_find.find(searchString);
+    if(m_pannableScrollbars) {
+        m_pannableScrollbars->invalidateTiles();
+    }
 
     emit matchesFound(m_find.hasMatches());
     centerToResult();
@@ -424,7 +429,6 @@ void OfficeViewerWord::showPage(int pageIndex)
 
 void OfficeViewerWord::prepareThumbnailer()
 {
-    KWDocument *doc = qobject_cast<KWDocument*>(m_document);
     m_thumbnailView = static_cast<KWView *>(m_document->createView());
 
     Q_CHECK_PTR(m_thumbnailView);
@@ -438,21 +442,38 @@ void OfficeViewerWord::prepareThumbnailer()
 //    foreach (KoShape *shape, canvas->shapeManager()->shapes()) {
 //        shape->waitUntilReady(*m_thumbnailView->viewConverter(), false);
 //    }
+}
 
-    while(! doc->layoutFinishedAtleastOnce()) {
-        QCoreApplication::processEvents();
+QImage * OfficeViewerWord::getThumbnail(int pageNumber)
+{
+    return new QImage(m_thumbnails.renderedThumbnail(pageNumber));
+}
 
-        if(! QCoreApplication::hasPendingEvents())
-            break;
-    }
+QImage OfficeViewerWord::thumbnail(int page)
+{
+    return m_thumbnails.thumbnail(page);
 }
 
-QImage * OfficeViewerWord::getThumbnail(int pageNumber)
+int OfficeViewerWord::thumbnailCount()
+{
+    return pageCount();
+}
+
+bool OfficeViewerWord::canRenderThumbnails()
+{
+    KWDocument *doc = qobject_cast<KWDocument*>(m_document);
+
+    // the thumbnails miss text until the pages have been laid out
+    return doc && m_canvasItem && doc->layoutFinishedAtleastOnce();
+}
+
+QImage OfficeViewerWord::renderThumbnail(int pageNumber)
 {
+    KWDocument *doc = qobject_cast<KWDocument*>(m_document);
+
     if (!m_thumbnailView) {
         prepareThumbnailer();
     }
-    KWDocument *doc = qobject_cast<KWDocument*>(m_document);
 
     KWPageManager *manager = doc->pageManager();
 
@@ -467,8 +488,8 @@ QImage * OfficeViewerWord::getThumbnail(int pageNumber)
     qDebug() << __PRETTY_FUNCTION__ << zoom;
     zoom = qMax(qreal(1.0), zoom);
 
-    QImage *image = new QImage(page.thumbnail((pageSize*zoom).toSize(), m_canvasItem->shapeManager()));
-    return image;
+    // 16 bit images take half the room in the cache
+    return page.thumbnail((pageSize*zoom).toSize(), m_canvasItem->shapeManager()).convertToFormat(QImage::Format_RGB16);
 }
 
 void OfficeViewerWord::shortTap(const QPointF &point, QObject *object)
@@ -530,6 +551,9 @@ void OfficeViewerWord::clearSearchResults()
     qDebug() << "clearSearchResults();";
 
     m_find.finished();
+    if(m_pannableScrollbars) {
+        m_pannableScrollbars->invalidateTiles();
+    }
 }
 
 void OfficeViewerWord::previousWord()
@@ -537,6 +561,9 @@ void OfficeViewerWord::previousWord()
     qDebug() << "previousWord";
 
     m_find.findPrevious();
+    if(m_pannableScrollbars) {
+        m_pannableScrollbars->invalidateTiles();
+    }
     centerToResult();
 }
 
@@ -545,6 +572,9 @@ void OfficeViewerWord::nextWord()
     qDebug() << "nextWord";
 
     m_find.findNext();
+    if(m_pannableScrollbars) {
+        m_pannableScrollbars->invalidateTiles();
+    }
     centerToResult();
 }
 
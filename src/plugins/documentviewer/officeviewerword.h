@@ -31,6 +31,7 @@
 #include "searchresult.h"
 #include "documentviewer_export.h"
 #include "officefind.h"
+#include "thumbnailcache.h"
 
 class QTextDocument;
 
@@ -53,7 +54,7 @@ class KWView;
  * view.
  */
 
-class DOCUMENTVIEWER_EXPORT OfficeViewerWord : public OfficeViewer
+class DOCUMENTVIEWER_EXPORT OfficeViewerWord : public OfficeViewer, public ThumbnailRenderer
 {
     Q_OBJECT
 
@@ -117,6 +118,16 @@ protected:
 
     virtual QImage * getThumbnail(int page);
 
+    /*!
+     * \brief Gets a thumbnail from the thumbnail cache without blocking
+     */
+    virtual QImage thumbnail(int page);
+
+    // ThumbnailRenderer implementation
+    virtual int thumbnailCount();
+    virtual bool canRenderThumbnails();
+    virtual QImage renderThumbnail(int pageIndex);
+
 private slots:
 
     void offsetInDocumentMoved(int yOffset);
@@ -158,6 +169,8 @@ private:
 
     KWView *m_thumbnailView;
 
+    ThumbnailCache m_thumbnails;
+
 };
 
 #endif // OFFICEVIEWERWORD_H
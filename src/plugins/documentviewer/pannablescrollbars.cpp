@@ -40,7 +40,9 @@
 #include <KoPACanvasItem.h>
 
 #include "pannablescrollbars.h"
+#include "canvastilecache.h"
 #include "applicationwindow.h"
+#include "officelog.h"
 
 PannableScrollBars::PannableScrollBars(QGraphicsItem *parent)
     : MPannableViewport(parent)
@@ -48,6 +50,7 @@ PannableScrollBars::PannableScrollBars(QGraphicsItem *parent)
     , m_zoomHandler(0)
     , m_canvas(0)
     , m_canvasItem(0)
+    , m_tileCache(0)
     , m_ignoreScrollSignals(false)
     , pinchInProgress(false)
     , updatePositionTimerRunning(false)
@@ -77,6 +80,8 @@ PannableScrollBars::~PannableScrollBars()
 
     setWidget(0);
 
+    delete m_tileCache;
+
     if (m_canvasItem) {
         m_canvasItem->removeEventFilter(this);
         delete m_canvasItem;
@@ -94,7 +99,7 @@ void PannableScrollBars::scrollContentsBy(int dx, int dy)
 QSize PannableScrollBars::viewportSize() const
 {
     QSize sz = ApplicationWindow::visibleSize();
-    qDebug() << "PannableScrollBars::viewportSize()" << sz;
+    OFFICE_LOG(Scroll) << "PannableScrollBars::viewportSize()" << sz;
     return sz;
 }
 
@@ -106,7 +111,7 @@ void PannableScrollBars::setDrawShadow(bool drawShadow)
 
 void PannableScrollBars::resizeEvent(QGraphicsSceneResizeEvent *event)
 {
-    qDebug() << __PRETTY_FUNCTION__ << event->newSize().toSize();
+    OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << event->newSize().toSize();
     MPannableViewport::resizeEvent(event);
     proxyObject->emitSizeChanged(event->newSize().toSize());
     resetLayout();
@@ -122,6 +127,9 @@ void PannableScrollBars::setCanvas(KoCanvasBase *canvas)
         setWidget(0);
     }
 
+    delete m_tileCache;
+    m_tileCache = 0;
+
     if(m_canvasItem) {
         m_canvasItem->removeEventFilter(this);
         m_canvasItem->hide();
@@ -149,6 +157,8 @@ void PannableScrollBars::setCanvas(KoCanvasBase *canvas)
 
     setWidget(m_canvasItem);
 
+    m_tileCache = new CanvasTileCache(m_canvasItem);
+
     resetLayout();
 
     m_canvasItem->installEventFilter(this);
@@ -235,9 +245,9 @@ int PannableScrollBars::canvasOffsetY() const
 
 void PannableScrollBars::ensureVisible(const QRectF &rect, bool smooth)
 {
-    qDebug() << __PRETTY_FUNCTION__ << rect << smooth;
+    OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << rect << smooth;
     QRect currentVisible(qMax(0, -canvasOffsetX()), qMax(0, -canvasOffsetY()), visibleWidth(), visibleHeight());
-    qDebug() << "currently visible" << currentVisible << -canvasOffsetX() << -canvasOffsetY() << visibleWidth() << visibleHeight() << ApplicationWindow::visibleSizeCorrect();
+    OFFICE_LOG(Scroll) << "currently visible" << currentVisible << -canvasOffsetX() << -canvasOffsetY() << visibleWidth() << visibleHeight() << ApplicationWindow::visibleSizeCorrect();
 
     MApplicationWindow *window = MApplication::activeApplicationWindow();
     if (window && window->currentPage()) {
@@ -249,19 +259,19 @@ void PannableScrollBars::ensureVisible(const QRectF &rect, bool smooth)
             // so this has to be taken into account
             QRectF geometry = this->geometry();
             QRectF contentArea = vRect.intersected(geometry);
-            qDebug() << __PRETTY_FUNCTION__ << vRect << geometry << contentArea << position();
+            OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << vRect << geometry << contentArea << position();
             currentVisible = contentArea.translated(position()).toRect();
-            qDebug() << __PRETTY_FUNCTION__ << currentVisible;
+            OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << currentVisible;
         }
     }
 
     QRect viewRect = rect.toRect();
     viewRect.translate(m_canvas->documentOrigin());
 
-    qDebug() << "viewRect" << viewRect << m_canvas->documentOrigin();
+    OFFICE_LOG(Scroll) << "viewRect" << viewRect << m_canvas->documentOrigin();
 
     if(!viewRect.isValid() || currentVisible.contains(viewRect)) {
-        qDebug() << "it is visible";
+        OFFICE_LOG(Scroll) << "it is visible";
         return; // its visible. Nothing to do.
     }
 
@@ -276,7 +286,7 @@ void PannableScrollBars::ensureVisible(const QRectF &rect, bool smooth)
     if(!smooth && viewRect.height() + jumpHeight > currentVisible.height())
         jumpHeight = 0;
 
-    qDebug() << __PRETTY_FUNCTION__ << jumpWidth << jumpHeight << currentVisible << smooth << viewRect;
+    OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << jumpWidth << jumpHeight << currentVisible << smooth << viewRect;
     int horizontalMove = 0;
 
     if(currentVisible.width() <= viewRect.width()) {      // center view
@@ -302,7 +312,7 @@ void PannableScrollBars::ensureVisible(const QRectF &rect, bool smooth)
         verticalMove = viewRect.bottom() - qMax(0, currentVisible.bottom() - jumpHeight);
     }
 
-    qDebug() << "panning to" << horizontalMove << verticalMove;
+    OFFICE_LOG(Scroll) << "panning to" << horizontalMove << verticalMove;
     QPointF pos = position() + QPointF(horizontalMove, verticalMove);
 
     setPosition(pos);
@@ -351,7 +361,7 @@ void PannableScrollBars::recenterPreferred()
 
 void PannableScrollBars::setPreferredCenter(const QPoint &viewPoint)
 {
-    qDebug() << "PannableScrollBars::setPreferredCenter" << viewPoint;
+    OFFICE_LOG(Scroll) << "PannableScrollBars::setPreferredCenter" << viewPoint;
     setPreferredCenterFractionX(1.0 * viewPoint.x() / documentSize().width());
     setPreferredCenterFractionY(1.0 * viewPoint.y() / documentSize().height());
     recenterPreferred();
@@ -363,8 +373,8 @@ QPoint PannableScrollBars::preferredCenter() const
     QPoint center;
     center.setX(qRound(preferredCenterFractionX() * documentSize().width()));
     center.setY(qRound(preferredCenterFractionY() * documentSize().height()));
-    qDebug() << "DOCUMENT SIZE " << documentSize();
-    qDebug() << "VIEW SIZE " << size();
+    OFFICE_LOG(Scroll) << "DOCUMENT SIZE " << documentSize();
+    OFFICE_LOG(Scroll) << "VIEW SIZE " << size();
     return center;
 }
 
@@ -464,13 +474,18 @@ void PannableScrollBars::updateDocumentSize(const QSize &sz, bool recalculateCen
 
     m_ignoreScrollSignals = true;
 
+    // the tiles were rendered at the old zoom
+    if (m_tileCache && sz != documentSize()) {
+        m_tileCache->invalidate();
+    }
+
     // the document size needs to be set before setRange is called so that it contains the correct data
     KoCanvasController::setDocumentSize(sz);
 
     updateRange();
 
     m_ignoreScrollSignals = oldIgnoreScrollSignals;
-    qDebug() << __PRETTY_FUNCTION__ << sz;
+    OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << sz;
 }
 
 void PannableScrollBars::updateRange()
@@ -497,33 +512,33 @@ void PannableScrollBars::updateRange()
         // the top for spreadsheet is different therfor fullRect.top cannot be used. Use 0.0 instead
         //if (vRect.top() > fullRect.top()) {
         if (vRect.top() > 0.0) {
-            qDebug() << __PRETTY_FUNCTION__ << "top hidden" << vRect.top() << fullRect.top() << vRect.top() - fullRect.top();
+            OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << "top hidden" << vRect.top() << fullRect.top() << vRect.top() - fullRect.top();
             beforeRange = -(vRect.top() - 0.0);
             heightRange += -beforeRange;
         }
         if (vRect.bottom() < fullRect.bottom()) {
-            qDebug() << __PRETTY_FUNCTION__ << "bottom hidden" << vRect.bottom() << fullRect.bottom() << vRect.bottom() - fullRect.bottom();
+            OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << "bottom hidden" << vRect.bottom() << fullRect.bottom() << vRect.bottom() - fullRect.bottom();
             heightRange = heightRange + fullRect.bottom() - vRect.bottom();
         }
     }
 
-    qDebug() << "vpSize" << vpSize;
+    OFFICE_LOG(Scroll) << "vpSize" << vpSize;
     setRange(QRectF(0.0, beforeRange, sz.width() - vpSize.width(), heightRange));
-    qDebug() << "RANGE:" << range() << sz << vpSize << geometry().size() << (m_canvasItem ? m_canvasItem->size() : QSizeF(0, 0));
+    OFFICE_LOG(Scroll) << "RANGE:" << range() << sz << vpSize << geometry().size() << (m_canvasItem ? m_canvasItem->size() : QSizeF(0, 0));
 
     resetLayout();
 }
 
 void PannableScrollBars::documentOffsetMoved(const QPoint& point)
 {
-    qDebug() << "PannableScrollBars::documentOffsetMoved(" << point;
+    OFFICE_LOG(Scroll) << "PannableScrollBars::documentOffsetMoved(" << point;
     Q_UNUSED(point);
     resetLayout();
 }
 
 void PannableScrollBars::resetLayout()
 {
-    qDebug() << "PannableScrollBars::resetLayout();";
+    OFFICE_LOG(Scroll) << "PannableScrollBars::resetLayout();";
     // Determine the area we have to show
     const QSize vpSize = viewportSize();
     const int viewH = vpSize.height();
@@ -538,23 +553,23 @@ void PannableScrollBars::resetLayout()
     int resizeW = viewW;
     int resizeH = viewH;
 
-    qDebug() << "resetLayout\n\tviewH:" << viewH << "\tdocH: " << docH << "\tviewW: " << viewW << "\tdocW: " << docW << range();
+    OFFICE_LOG(Scroll) << "resetLayout\n\tviewH:" << viewH << "\tdocH: " << docH << "\tviewW: " << viewW << "\tdocW: " << docW << range();
 
     if(viewH == docH && viewW == docW) {
-        qDebug() << "1";
+        OFFICE_LOG(Scroll) << "1";
         // Do nothing
         resizeW = docW;
         resizeH = docH;
     } else if(viewH >= docH && viewW >= docW) {
         // Show entire canvas centered
-        qDebug() << "2";
+        OFFICE_LOG(Scroll) << "2";
         moveX = (viewW - docW) / 2;
         moveY = (viewH - docH) / 2;
         resizeW = docW;
         resizeH = docH;
     } else  if(viewW > docW) {
         // Center canvas horizontally
-        qDebug() << "3";
+        OFFICE_LOG(Scroll) << "3";
         moveX = (viewW - docW) / 2;
         resizeW = docW;
 
@@ -567,7 +582,7 @@ void PannableScrollBars::resetLayout()
 
         if(marginBottom > 0) resizeH = viewH - marginBottom;
     } else  if(viewH > docH) {
-        qDebug() << "4";
+        OFFICE_LOG(Scroll) << "4";
         // Center canvas vertically
         moveY = (viewH - docH) / 2;
         resizeH = docH;
@@ -586,7 +601,7 @@ void PannableScrollBars::resetLayout()
         int marginLeft = margin() - documentOffset().x();
         int marginRight = viewW - (documentSize().width() - documentOffset().x());
         int marginBottom = viewH  - (documentSize().height() - documentOffset().y());
-        qDebug() << "5" << marginTop << marginLeft << marginRight << marginBottom << margin() << documentOffset();
+        OFFICE_LOG(Scroll) << "5" << marginTop << marginLeft << marginRight << marginBottom << margin() << documentOffset();
 
         if(marginTop > 0) moveY = marginTop;
 
@@ -629,13 +644,13 @@ void PannableScrollBars::resetLayout()
                 }
             }
             geom = QRect(moveX, moveY, resizeW, resizeH);
-            qDebug() << "geo update" << org << geom << m_lastPosition;
+            OFFICE_LOG(Scroll) << "geo update" << org << geom << m_lastPosition;
         }
 
-        qDebug() << "geometry" << geom << m_canvasItem->geometry();
+        OFFICE_LOG(Scroll) << "geometry" << geom << m_canvasItem->geometry();
         if(m_canvasItem->geometry() != geom) {
             m_canvasItem->setGeometry(geom);
-            qDebug() << "geometry now" << m_canvasItem->geometry();
+            OFFICE_LOG(Scroll) << "geometry now" << m_canvasItem->geometry();
         }
     }
 }
@@ -653,25 +668,23 @@ void PannableScrollBars::updatePosition(const QPointF &position)
 {
     // don't do anything if the position has not changed
     if (position == m_lastPosition || pinchInProgress || m_updatingPosition ) {
-        qDebug() << "updatePosition canceled" << m_lastPosition << position << range() << physics()->inMotion();
+        OFFICE_LOG(Scroll) << "updatePosition canceled" << m_lastPosition << position << range() << physics()->inMotion();
         m_lostPanGesture = false;
         return;
     }
 
     m_updatingPosition = true;
 
-    qDebug() << "updatePosition" << m_lastPosition << position << range() << physics()->inMotion();
+    OFFICE_LOG(Scroll) << "updatePosition" << m_lastPosition << position << range() << physics()->inMotion();
 
     MPositionIndicator *pi = positionIndicator();
     if (pi) {
         pi->setPosition(position);
-        qDebug() << pi->position() << pi->range() << pi->isEnabled() << pi->viewportSize() << pi->zValue();
+        OFFICE_LOG(Scroll) << pi->position() << pi->range() << pi->isEnabled() << pi->viewportSize() << pi->zValue();
     }
 
     if (m_canvasItem) {
-        m_canvasItem->setCacheMode(QGraphicsItem::NoCache);
-
-        qDebug() << "PannableScrollBars::updatePosition();" << position << m_lastPosition << canvasOffsetX() << canvasOffsetY()
+        OFFICE_LOG(Scroll) << "PannableScrollBars::updatePosition();" << position << m_lastPosition << canvasOffsetX() << canvasOffsetY()
             << m_canvasItem->pos() << this->position() << documentOffset() << range() << geometry() << autoFillBackground();
 
         //MPannableViewport::updatePosition(position);
@@ -699,11 +712,11 @@ void PannableScrollBars::updatePosition(const QPointF &position)
             m_panDirection = PanUp;
         }
 
-        qDebug() << __PRETTY_FUNCTION__ << "panning" << isPanning();
+        OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << "panning" << isPanning();
         if (isPanning()) {
             qreal bottom = range().bottom();
             qreal top = range().top();
-            qDebug() << __PRETTY_FUNCTION__ << top << bottom << p << m_lastPosition;
+            OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << top << bottom << p << m_lastPosition;
             if (p.y() < top && m_lastPosition.y() == top) {
                 emit topReached(m_lastPosition);
             }
@@ -716,26 +729,51 @@ void PannableScrollBars::updatePosition(const QPointF &position)
         proxyObject->emitMoveDocumentOffset(p.toPoint());
         emit panWidgets(position.x(), position.y());
 
-        m_canvasItem->update();
+        // only the tiles coming into view are painted instead of the whole canvas
+        if (m_tileCache) {
+            m_tileCache->setVisibleAreaOnly(canvasMode() == KoCanvasController::Spreadsheet);
+            if (m_zoomHandler) {
+                m_tileCache->setZoom(m_zoomHandler->zoom());
+            }
+            m_tileCache->scrollTo(p.toPoint());
+        }
     }
-    qDebug() << "updatePosition finished";
+    OFFICE_LOG(Scroll) << "updatePosition finished";
     m_updatingPosition = false;
     m_lostPanGesture = false;
 }
 
+void PannableScrollBars::invalidateTiles()
+{
+    if (m_tileCache) {
+        m_tileCache->invalidate();
+    }
+}
+
 void PannableScrollBars::pinchStarted()
 {
     pinchInProgress = true;
+    // the page is scaled with a snapshot of the canvas while pinching
+    if (m_tileCache) {
+        m_tileCache->freeze();
+    }
 }
 
 void PannableScrollBars::pinchFinished()
 {
     pinchInProgress = false;
+    // the viewers have set the new zoom, the canvas renders it once
+    if (m_tileCache) {
+        m_tileCache->deactivate();
+    }
 }
 
 void PannableScrollBars::updatePositionTimeout()
 {
     if(!physics()->inMotion()) {
+        if (m_tileCache && !pinchInProgress) {
+            m_tileCache->deactivate();
+        }
         m_canvasItem->setCacheMode(QGraphicsItem::ItemCoordinateCache);
     }
 
@@ -744,6 +782,9 @@ void PannableScrollBars::updatePositionTimeout()
 
 void PannableScrollBars::panningStopped()
 {
+    if (m_tileCache && !pinchInProgress) {
+        m_tileCache->deactivate();
+    }
     m_canvasItem->setCacheMode(QGraphicsItem::ItemCoordinateCache);
 }
 
@@ -759,7 +800,7 @@ void PannableScrollBars::gestureEvent(QGestureEvent *event)
 {
     // get the active gestures
     QList<QGesture *> gestures = event->activeGestures();
-    qDebug() << __PRETTY_FUNCTION__ << event << event->type() << event->gesture(Qt::PinchGesture) << gestures.size();
+    OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << event << event->type() << event->gesture(Qt::PinchGesture) << gestures.size();
     foreach (QGesture * gesture, gestures) {
         //qDebug() << __PRETTY_FUNCTION__ << "    " << gesture << gesture->state();
 
@@ -771,13 +812,13 @@ void PannableScrollBars::gestureEvent(QGestureEvent *event)
     }
 
     if (pinchInProgress) {
-        qDebug() << __PRETTY_FUNCTION__ << "event ignored pinch in progress";
+        OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << "event ignored pinch in progress";
         event->ignore();
         m_gesturesToCancel = gestures;
     }
     else {
         if (gestures == m_gesturesToCancel) {
-            qDebug() << __PRETTY_FUNCTION__ << "event ignored";
+            OFFICE_LOG(Scroll) << __PRETTY_FUNCTION__ << "event ignored";
             event->ignore();
         }
         else {
@@ -30,6 +30,7 @@
 class QScrollBar;
 
 class KoZoomHandler;
+class CanvasTileCache;
 
 /*!
  * \class PannableScrollBars
@@ -88,6 +89,12 @@ public:
     void pinchFinished();
     void resetLayout();
 
+    /*!
+     * \brief Drops the tiles shown while panning, needed when the viewer
+     * changes what the canvas shows without changing the zoom
+     */
+    void invalidateTiles();
+
     // Dummy Implementation of Abstract class KoCanvasController
     // to make compiler happy
     void setZoomWithWheel(bool value) {
@@ -132,6 +139,8 @@ private:
     const KoZoomHandler *m_zoomHandler;
     KoCanvasBase *m_canvas;
     QGraphicsWidget *m_canvasItem;
+    //! Shows the canvas while it is panned
+    CanvasTileCache *m_tileCache;
     int m_margin;
     bool m_ignoreScrollSignals;
     bool pinchInProgress;
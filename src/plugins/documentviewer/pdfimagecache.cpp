@@ -27,6 +27,9 @@
 #include <QDebug>
 
 #include "pdfpagewidget.h"
+#include "tracepoint.h"
+#include "officelog.h"
+#include "perfcounters.h"
 
 static const int MAX_CACHE_SIZE = 60000000;
 
@@ -44,7 +47,7 @@ struct PdfImageData
     void update(const QImage &newImage, qreal newScale)
     {
         image = newImage;
-        qDebug() << __PRETTY_FUNCTION__ << "updating scale" << scale << newScale;
+        OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "updating scale" << scale << newScale;
         scale = newScale;
         scaled = false;
         updating = false;
@@ -56,7 +59,7 @@ struct PdfImageData
         int width  = image.size().width() * tempScale;
         int height = image.size().height() * tempScale;
         image = image.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        qDebug() << __PRETTY_FUNCTION__ << "updating scale" << scale << newScale << image.size();
+        OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "updating scale" << scale << newScale << image.size();
         scale = newScale;
         scaled = true;
         updating = false;
@@ -85,6 +88,7 @@ public:
     Private(int pageCount)
     : images(pageCount)
     , size(0)
+    , bytes(0)
     , count(0)
     , currentUseCount(0)
     , cleanupPosition(0)
@@ -97,7 +101,10 @@ public:
 
     QVector<PdfImageData> images;
     QMutex mutex;
+    //! Pixels of the page images, limited to MAX_CACHE_SIZE
     int size;
+    //! Bytes of the page images and thumbnails
+    qint64 bytes;
     int count;
     int currentUseCount;
     int cleanupPosition;
@@ -110,6 +117,7 @@ PdfImageCache::PdfImageCache(int pageCount)
 
 PdfImageCache::~PdfImageCache()
 {
+    PerfCounters::add(PerfCounters::CacheBytes, -d->bytes);
 }
 
 QImage PdfImageCache::getImage(int pageIndex, qreal scale, PdfPageWidget *pageWidget)
@@ -123,15 +131,20 @@ QImage PdfImageCache::getImage(int pageIndex, qreal scale, PdfPageWidget *pageWi
     d->images[pageIndex].pageWidget = pageWidget;
 
     if (data.scale == scale) {
-        qDebug() << __PRETTY_FUNCTION__ << "image in cache" << data.scaled << data.scale << scale << qAbs(data.scale - scale);
+        OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "image in cache" << data.scaled << data.scale << scale << qAbs(data.scale - scale);
+        TracePoint::mark("cacheHit", "cache", "page", pageIndex);
+        PerfCounters::add(PerfCounters::CacheHits);
         updateUseCount(data);
         return data.image;
     }
     else if (!data.scaled && qAbs(data.scale - scale) < 20) {
         // use scale current image and use that.
-        qDebug() << __PRETTY_FUNCTION__ << "scaled" << data.scaled << data.scale << scale << qAbs(data.scale - scale);
+        OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "scaled" << data.scaled << data.scale << scale << qAbs(data.scale - scale);
+        TracePoint::mark("cacheScaled", "cache", "page", pageIndex);
+        PerfCounters::add(PerfCounters::CacheHits);
         QSize oldSize(data.image.size());
         int oldImageSize(oldSize.width() * oldSize.height());
+        const int oldBytes = data.image.byteCount();
 
         data.scaleImage(scale);
         updateUseCount(data);
@@ -139,13 +152,18 @@ QImage PdfImageCache::getImage(int pageIndex, qreal scale, PdfPageWidget *pageWi
         QSize size(data.image.size());
         int imageSize = size.width() * size.height();
         d->size = d->size + imageSize - oldImageSize;
+        const int addedBytes = data.image.byteCount() - oldBytes;
+        d->bytes += addedBytes;
+        PerfCounters::add(PerfCounters::CacheBytes, addedBytes);
 
         return data.image;
     }
     else {
+        TracePoint::mark("cacheMiss", "cache", "page", pageIndex);
         QImage image = data.image;
         if (!data.updating) {
-            qDebug() << __PRETTY_FUNCTION__ << "update scale" << data.scaled << data.scale << scale << qAbs(data.scale - scale);
+            PerfCounters::add(PerfCounters::CacheMisses);
+            OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "update scale" << data.scaled << data.scale << scale << qAbs(data.scale - scale);
             data.updating = true;
             lock.unlock();
             // trigger loading of page
@@ -170,6 +188,9 @@ void PdfImageCache::setImage(int pageIndex, qreal scale, const QImage &image)
     QSize oldSize(data.image.size());
     int oldImageSize(oldSize.width() * oldSize.height());
     d->size = d->size + imageSize - oldImageSize;
+    const int addedBytes = image.byteCount() - data.image.byteCount();
+    d->bytes += addedBytes;
+    PerfCounters::add(PerfCounters::CacheBytes, addedBytes);
     data.update(image, scale);
     updateUseCount(data);
     PdfPageWidget *pageWidget = data.pageWidget;
@@ -177,7 +198,7 @@ void PdfImageCache::setImage(int pageIndex, qreal scale, const QImage &image)
         cleanupCache();
     }
     lock.unlock();
-    qDebug() << __PRETTY_FUNCTION__ << pageIndex << scale << pageWidget << image.size() << d->size;
+    OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << pageIndex << scale << pageWidget << image.size() << d->size;
 
     // trigger repainting of page
     if (pageWidget) {
@@ -185,6 +206,12 @@ void PdfImageCache::setImage(int pageIndex, qreal scale, const QImage &image)
     }
 }
 
+qint64 PdfImageCache::memoryUsage() const
+{
+    QMutexLocker lock(&d->mutex);
+    return d->bytes;
+}
+
 void PdfImageCache::updateUseCount(PdfImageData &data)
 {
     // we already have the lock when this function is called
@@ -196,7 +223,7 @@ void PdfImageCache::updateUseCount(PdfImageData &data)
 void PdfImageCache::cleanupCache()
 {
     // we already have the lock when this function is called
-    qDebug() << __PRETTY_FUNCTION__ << d->size << d->cleanupPosition;
+    OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << d->size << d->cleanupPosition;
     bool finished = false;
     int newCleanupPosition = d->cleanupPosition;
     for (int i = d->cleanupPosition; i < d->images.size() && !finished; ++i) {
@@ -208,7 +235,7 @@ void PdfImageCache::cleanupCache()
         newCleanupPosition = i;
     }
     d->cleanupPosition = newCleanupPosition;
-    qDebug() << __PRETTY_FUNCTION__ << d->size << d->cleanupPosition;
+    OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << d->size << d->cleanupPosition;
 }
 
 bool PdfImageCache::cleanupCacheEntry(int index)
@@ -218,14 +245,17 @@ bool PdfImageCache::cleanupCacheEntry(int index)
     QSize size(data.image.size());
     int imageSize = size.width() * size.height();
 
-    qDebug() << __PRETTY_FUNCTION__ << "check" << index << imageSize << data.useCount << d->currentUseCount - 2 << data.updating;
+    OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "check" << index << imageSize << data.useCount << d->currentUseCount - 2 << data.updating;
 
     if (data.useCount < d->currentUseCount - 2 && imageSize > 0 && data.updating == false) {
-        qDebug() << __PRETTY_FUNCTION__ << "removing" << index << imageSize;
+        OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "removing" << index << imageSize;
+        d->bytes -= data.image.byteCount();
+        PerfCounters::add(PerfCounters::CacheBytes, -data.image.byteCount());
         data.image = QImage();
         data.scale = -20;
         data.scaled = 0;
         d->size -= imageSize;
+        PerfCounters::add(PerfCounters::CacheEvictions);
         if (d->size < MAX_CACHE_SIZE) {
             return true;
         }
@@ -235,7 +265,7 @@ bool PdfImageCache::cleanupCacheEntry(int index)
 
 QImage PdfImageCache::getThumbnail(int pageIndex, qreal scale)
 {
-    qDebug() << __PRETTY_FUNCTION__ << pageIndex << scale;
+    OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << pageIndex << scale;
     if (pageIndex < 0 || pageIndex >= d->images.size()) {
         return QImage();
     }
@@ -244,7 +274,7 @@ QImage PdfImageCache::getThumbnail(int pageIndex, qreal scale)
     PdfImageData &data = d->images[pageIndex];
 
     if (data.thumbnail.isNull() && !data.updatingThumbnail) {
-        qDebug() << __PRETTY_FUNCTION__ << "loadThumbnail" << pageIndex << scale;
+        OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << "loadThumbnail" << pageIndex << scale;
         data.updatingThumbnail = true;
         lock.unlock();
         emit loadThumbnail(pageIndex, scale);
@@ -254,9 +284,12 @@ QImage PdfImageCache::getThumbnail(int pageIndex, qreal scale)
 
 void PdfImageCache::setThumbnail(int pageIndex, const QImage &image)
 {
-    qDebug() << __PRETTY_FUNCTION__ << pageIndex;
+    OFFICE_LOG(Cache) << __PRETTY_FUNCTION__ << pageIndex;
     QMutexLocker lock(&d->mutex);
     PdfImageData &data = d->images[pageIndex];
+    const int addedBytes = image.byteCount() - data.thumbnail.byteCount();
+    d->bytes += addedBytes;
+    PerfCounters::add(PerfCounters::CacheBytes, addedBytes);
     data.updateThumbnail(image);
 
     emit thumbnailLoaded(pageIndex);
@@ -45,6 +45,9 @@ public:
     QImage getThumbnail(int pageIndex, qreal scale);
     void setThumbnail(int pageIndex, const QImage &image);
 
+    //! Bytes used by the page images and thumbnails
+    qint64 memoryUsage() const;
+
 signals:
     void loadPage(int pageIndex, qreal scale);
     void loadThumbnail(int pageIndex, qreal scale);
@@ -38,6 +38,7 @@
 #include "pdfpagewidget.h"
 #include "applicationwindow.h"
 #include "pdfloaderthread.h"
+#include "tracepoint.h"
 
 class PdfLoaderPrivate
 {
@@ -70,6 +71,7 @@ PdfLoader::PdfLoader(QObject *parent)
     , highlightCurrentPosition(0)
     , thread(0)
     , m_imageCache(0)
+    , m_painted(false)
 {
     qDebug() << __PRETTY_FUNCTION__ ;
     connect(this, SIGNAL(loadNeighborPagesRequest()), this, SLOT(loadNeighborPages()));
@@ -106,6 +108,7 @@ bool PdfLoader::load(const QString &filename,Poppler::Document* &mDocument)
     qDebug() << __PRETTY_FUNCTION__ ;
     bool retval = false;
     clear();
+    m_painted = false;
     document = Poppler::Document::load(filename);
 
     if(0 != document) {
@@ -429,11 +432,24 @@ QImage PdfLoader::getPageImage(int pageIndex, qreal scale, PdfPageWidget *pageWi
     return m_imageCache->getImage(pageIndex, scale, pageWidget);
 }
 
+void PdfLoader::pagePainted(int pageIndex)
+{
+    if (!m_painted) {
+        m_painted = true;
+        TracePoint::mark("firstPaint", "startup", "page", pageIndex);
+    }
+}
+
 void PdfLoader::updatePage(PdfPageWidget *pageWidget)
 {
     pageWidget->update();
 }
 
+qint64 PdfLoader::memoryUsage() const
+{
+    return m_imageCache ? m_imageCache->memoryUsage() : 0;
+}
+
 QImage PdfLoader::getThumbnail(int pageIndex, qreal scale)
 {
     if (m_imageCache == 0) {
@@ -192,6 +192,18 @@ public:
      */
     QImage getThumbnail(int pageIndex, qreal scale);
 
+    /*!
+     * \brief Gets the memory used by the rendered pages
+     * \return The size in bytes
+     */
+    qint64 memoryUsage() const;
+
+    /*!
+     * \brief Marks the first paint of a page of the loaded document in the trace
+     * \param pageIndex The page that was painted
+     */
+    void pagePainted(int pageIndex);
+
 public slots:
     /*!
      * \brief Removes page images that are not used currently.
@@ -235,6 +247,8 @@ private:
     int       highlightCurrentPosition;
     PdfLoaderThread             *thread;
     PdfImageCache *m_imageCache;
+    //! Whether a page of the loaded document has been painted
+    bool m_painted;
 };
 
 #endif // PDFLOADER_H
@@ -37,6 +37,9 @@
 #include "pdfimagecache.h"
 #include "pdfloaderthread.h"
 #include "definitions.h"
+#include "tracepoint.h"
+#include "officelog.h"
+#include "perfcounters.h"
 
 class PdfLoaderThread::Private
 {
@@ -45,6 +48,7 @@ public:
     : document(0)
     , imageCache(0)
     , stopLoading(false)
+    , firstRender(true)
     {}
 
     ~Private()
@@ -55,6 +59,8 @@ public:
     Poppler::Document *document;
     PdfImageCache *imageCache;
     bool stopLoading;
+    //! Whether no page of the document has been rendered yet
+    bool firstRender;
 
     QQueue<QPair<int, qreal> > queuedPages;
     QMutex queueMutex;
@@ -73,7 +79,7 @@ PdfLoaderThread::PdfLoaderThread(const QString & pdfFileName, PdfImageCache *ima
     data->document = Poppler::Document::load(pdfFileName);
 
     if(0 != data->document) {
-        qDebug() << "setRenderHint";
+        OFFICE_LOG(Render) << "setRenderHint";
         data->document->setRenderHint(Poppler::Document::Antialiasing, true);
         data->document->setRenderHint(Poppler::Document::TextAntialiasing, true);
     }
@@ -86,6 +92,9 @@ PdfLoaderThread::~PdfLoaderThread()
 {
     //qDebug() << __PRETTY_FUNCTION__ ;
     //disconnect(this, SIGNAL(continueLoading()), this, SLOT(loadPendingItems()));
+    // the queues of all loaders add up to the counter
+    PerfCounters::add(PerfCounters::RenderQueueDepth,
+                      -(data->queuedPages.size() + data->queuedThumbnail.size()));
     delete data;
 }
 
@@ -100,10 +109,11 @@ void PdfLoaderThread::loadPage(int pageIndex, qreal scale)
         return;
     }
 
-    qDebug() << __PRETTY_FUNCTION__ << pageIndex << scale << QThread::currentThread();
+    OFFICE_LOG(Render) << __PRETTY_FUNCTION__ << pageIndex << scale << QThread::currentThread();
 
     QMutexLocker lock(&data->queueMutex);
     data->queuedPages.enqueue(QPair<int, qreal>(pageIndex, scale));
+    PerfCounters::add(PerfCounters::RenderQueueDepth);
     lock.unlock();
 
     // trigger loading
@@ -112,7 +122,7 @@ void PdfLoaderThread::loadPage(int pageIndex, qreal scale)
 
 void PdfLoaderThread::loadQueuedPage()
 {
-    qDebug() << __PRETTY_FUNCTION__ << QThread::currentThread();
+    OFFICE_LOG(Render) << __PRETTY_FUNCTION__ << QThread::currentThread();
 
     if (0 == data->document || data->stopLoading) {
         return;
@@ -120,19 +130,32 @@ void PdfLoaderThread::loadQueuedPage()
 
     QMutexLocker lock(&data->queueMutex);
     QPair<int, qreal> pageData = data->queuedPages.dequeue();
+    PerfCounters::add(PerfCounters::RenderQueueDepth, -1);
     lock.unlock();
 
-    qDebug() << __PRETTY_FUNCTION__ << pageData.first << pageData.second;
+    OFFICE_LOG(Render) << __PRETTY_FUNCTION__ << pageData.first << pageData.second;
+
+    TracePoint trace("renderPage", "render");
+    trace.setArgument("page", pageData.first);
 
     QImage image;
-    Poppler::Page *page = data->document->page(pageData.first);
-    image = page->renderToImage(pageData.second, pageData.second);
-    delete page;
+    {
+        PerfTimer timer(PerfCounters::RenderTime);
+        Poppler::Page *page = data->document->page(pageData.first);
+        image = page->renderToImage(pageData.second, pageData.second);
+        delete page;
+    }
     if (data->imageCache) {
         // TODO is the convert needed?
         QImage tmpImage = image.convertToFormat(QImage::Format_RGB16, Qt::AutoColor);
         data->imageCache->setImage(pageData.first, pageData.second, tmpImage);
     }
+
+    // a loader thread is created for each document
+    if (data->firstRender) {
+        data->firstRender = false;
+        TracePoint::mark("firstRender", "startup", "page", pageData.first);
+    }
 }
 
 void PdfLoaderThread::loadThumbnail(int pageIndex, qreal scale)
@@ -141,10 +164,11 @@ void PdfLoaderThread::loadThumbnail(int pageIndex, qreal scale)
         return;
     }
 
-    qDebug() << __PRETTY_FUNCTION__ << pageIndex << scale << QThread::currentThread();
+    OFFICE_LOG(Render) << __PRETTY_FUNCTION__ << pageIndex << scale << QThread::currentThread();
 
     QMutexLocker lock(&data->thumbnailMutex);
     data->queuedThumbnail.enqueue(QPair<int, qreal>(pageIndex, scale));
+    PerfCounters::add(PerfCounters::RenderQueueDepth);
     lock.unlock();
 
     // trigger loading
@@ -153,7 +177,7 @@ void PdfLoaderThread::loadThumbnail(int pageIndex, qreal scale)
 
 void PdfLoaderThread::loadQueuedThumbnail()
 {
-    qDebug() << __PRETTY_FUNCTION__ << QThread::currentThread();
+    OFFICE_LOG(Render) << __PRETTY_FUNCTION__ << QThread::currentThread();
 
     if (0 == data->document || data->stopLoading) {
         return;
@@ -161,14 +185,21 @@ void PdfLoaderThread::loadQueuedThumbnail()
 
     QMutexLocker lock(&data->thumbnailMutex);
     QPair<int, qreal> pageData = data->queuedThumbnail.dequeue();
+    PerfCounters::add(PerfCounters::RenderQueueDepth, -1);
     lock.unlock();
 
-    qDebug() << __PRETTY_FUNCTION__ << pageData.first << pageData.second;
+    OFFICE_LOG(Render) << __PRETTY_FUNCTION__ << pageData.first << pageData.second;
+
+    TracePoint trace("renderThumbnail", "render");
+    trace.setArgument("page", pageData.first);
 
     QImage image;
-    Poppler::Page *page = data->document->page(pageData.first);
-    image = page->renderToImage(pageData.second, pageData.second);
-    delete page;
+    {
+        PerfTimer timer(PerfCounters::ThumbnailRenderTime);
+        Poppler::Page *page = data->document->page(pageData.first);
+        image = page->renderToImage(pageData.second, pageData.second);
+        delete page;
+    }
     if (data->imageCache) {
         // TODO is the convert needed?
         QImage tmpImage = image.convertToFormat(QImage::Format_RGB16, Qt::AutoColor);
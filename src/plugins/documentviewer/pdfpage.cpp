@@ -26,7 +26,7 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QtGlobal>
 #include <QDir>
-#include <QPluginLoader>
+#include <QFileInfo>
 #include <QReadWriteLock>
 
 #include <MLayout>
@@ -45,8 +45,11 @@
 #include "pdfthumbprovider.h"
 #include "misc.h"
 #include "pdfsearch.h"
+#include "readingposition.h"
+#include "tracepoint.h"
 
 #include "OfficeInterface.h"
+#include "pluginmanifest.h"
 
 class PdfPage::Private
 {
@@ -76,6 +79,7 @@ public:
     PdfThumbProvider        thumbProvider;
     QSizeF                  lastViewportSize;
     PdfSearch               *search;
+    ReadingPosition         position;
 };
 
 PdfPage::PdfPage(const QString& filename, QGraphicsItem *parent)
@@ -84,7 +88,7 @@ PdfPage::PdfPage(const QString& filename, QGraphicsItem *parent)
     , mDocument(0)
     , enable(false)
 {
-    connect(ApplicationWindow::GetSceneManager(), SIGNAL(orientationChangeFinished(const M::Orientation &)),
+    connect(this, SIGNAL(sceneOrientationChangeFinished(const M::Orientation &)),
             this, SLOT(orientationChanged()));
 
     d->loader.setHighlightData(&searchData);
@@ -97,6 +101,7 @@ PdfPage::PdfPage(const QString& filename, QGraphicsItem *parent)
 
 PdfPage::~PdfPage()
 {
+    saveReadingPosition();
     stopSearchThreads();
 
     qDebug() << __PRETTY_FUNCTION__;
@@ -117,33 +122,11 @@ void PdfPage::createContent()
     createPdfView();
 
     initUI();
+}
 
-    const QDir pluginDir("/usr/lib/office-tools/plugins");
-    const QStringList plugins = pluginDir.entryList(QDir::Files);
-
-    for (int i = 0; i < plugins.size(); ++i) {
-        QPluginLoader test(pluginDir.absoluteFilePath(plugins.at(i)));
-        QObject *plug = test.instance();
-        if (plug != 0) {
-
-            OfficeInterface* inter = qobject_cast<OfficeInterface*>(plug);
-
-            if (inter) {
-                plug->setParent(this);
-
-                if (inter && inter->pluginType() == "pdf") { // Other types not supported here
-                    MAction *pluginAction = new MAction(inter->pluginName(), this);
-                    connect(pluginAction, SIGNAL(triggered()), plug, SLOT(emitOpenSignal()));
-                    connect(plug, SIGNAL(openMe(OfficeInterface*)), this, SLOT(openPlugin(OfficeInterface*)));
-                    pluginAction->setLocation(MAction::ApplicationMenuLocation);
-                    addAction(pluginAction);
-                }
-                else {
-                    delete plug;
-                }
-            }
-        }
-    }
+void PdfPage::addPluginActions()
+{
+    PluginManifest::addActions(this, "pdf", this, SLOT(openPlugin(OfficeInterface*)));
 }
 
 void PdfPage::createPdfView()
@@ -185,6 +168,7 @@ void PdfPage::createPdfView()
 
 void PdfPage::loadDocument()
 {
+    TracePoint trace("loadDocument", "startup");
     d->widgetList.clear();
     d->loader.setScene(d->innerWidget->scene());
     d->loader.setWidgetName(PDFPAGEWIDGET);
@@ -198,6 +182,17 @@ void PdfPage::loadDocument()
         return;
     }
 
+    d->position = ReadingPosition::load(documentName);
+    if (d->position.page >= d->loader.numberOfPages()) {
+        d->position = ReadingPosition();
+    }
+
+    if (d->position.isValid()) {
+        // The page the user was reading is rendered before the layout,
+        // the neighbour pages and the thumbnails ask for anything
+        d->loader.getPageImage(d->position.page, initialScale(d->position.page, d->position.zoom), 0);
+    }
+
     d->search = new PdfSearch(mDocument, searchData);
 
     connect(&d->loader, SIGNAL(pageChanged(int, int)), this, SLOT(setPageCounters(int, int)), Qt::QueuedConnection);
@@ -220,17 +215,89 @@ void PdfPage::loadDocument()
         d->innerLayout->setAlignment(w, Qt::AlignHCenter);
     }
 
-    //Lest set default start zooming level
-    ActionPool::instance()->getAction(ActionPool::ZoomFitToWidth)->trigger();
+    switch (d->position.zoom.getMode()) {
+    case ZoomLevel::FitToPage:
+        ActionPool::instance()->getAction(ActionPool::ZoomFitToPage)->trigger();
+        break;
+    case ZoomLevel::FactorMode: {
+        qreal factor = 1.0;
+        d->position.zoom.getFactor(factor);
+        ActionPool::instance()->setUserDefinedZoomFactor(factor);
+        zoom(d->position.zoom, false);
+        break;
+    }
+    case ZoomLevel::FitToHeight:
+        zoom(d->position.zoom, false);
+        break;
+    default:
+        //Lest set default start zooming level
+        ActionPool::instance()->getAction(ActionPool::ZoomFitToWidth)->trigger();
+        break;
+    }
 
     d->thumbProvider.init(scene(), PDFPAGEWIDGET);
-    d->loader.setCurrentPage(0);
+
+    if (d->position.isValid()) {
+        d->loader.setCurrentPage(d->position.page);
+        // The viewport range is known once the layout has been updated
+        QMetaObject::invokeMethod(this, "restoreReadingPosition", Qt::QueuedConnection);
+    } else {
+        d->loader.setCurrentPage(0);
+    }
 
     emit(loadSuccess(documentName));
 
     pageLoaded = true;
 }
 
+qreal PdfPage::initialScale(int pageIndex, const ZoomLevel &level) const
+{
+    // The same scale the page widget gets from zoom(), so the prerendered
+    // image is used as it is
+    return PdfPageWidget::scaleForZoom(ApplicationWindow::visibleSizeCorrect(), level,
+                                       d->loader.pageSize(pageIndex), PdfLoader::DPIPerInch);
+}
+
+void PdfPage::restoreReadingPosition()
+{
+    const int pageIndex = d->position.page;
+    if (pageIndex < 0 || pageIndex >= d->widgetList.size()) {
+        return;
+    }
+
+    PdfPageWidget *widget = d->widgetList.at(pageIndex);
+    const QPointF pagePoint(d->position.offset.x() * widget->size().width(),
+                            d->position.offset.y() * widget->size().height());
+    const QPointF position = d->viewport->widget()->mapFromItem(widget, pagePoint);
+
+    d->viewport->setPosition(normalilizePoint(position, d->viewport->range().bottomRight()));
+    d->loader.setCurrentPage(pageIndex);
+}
+
+void PdfPage::saveReadingPosition()
+{
+    const int pageIndex = d->loader.getCurrentPageIndex();
+    if (!pageLoaded || pageIndex < 0 || pageIndex >= d->widgetList.size()) {
+        return;
+    }
+
+    PdfPageWidget *widget = d->widgetList.at(pageIndex);
+    const QSizeF size = widget->size();
+    if (size.isEmpty()) {
+        return;
+    }
+
+    const QPointF point = widget->mapFromItem(d->viewport->widget(), d->viewport->position());
+
+    ReadingPosition position;
+    position.page = pageIndex;
+    position.offset = normalilizePoint(QPointF(point.x() / size.width(), point.y() / size.height()),
+                                       QPointF(1.0, 1.0));
+    position.zoom = m_lastZoom.isFitTo() ? m_lastZoom
+                                         : ZoomLevel(ZoomLevel::FactorMode, widget->calcZoomFactor());
+    position.save(documentName);
+}
+
 void PdfPage::zoom(ZoomLevel level)
 {
     zoom(level, !m_blockRecenter);
@@ -336,6 +403,7 @@ void PdfPage::startSearch(const QString &searchText)
     if(!searchText.isEmpty()) {
         stopSearchThreads();
 
+        TracePoint::mark("startSearch", "search", "page", currentPage);
         d->search->setData(searchText, currentPage);
 
         qDebug()<<"d->search start**";
@@ -770,6 +838,12 @@ ThumbProvider* PdfPage::getThumbProvider()
     return &d->thumbProvider;
 }
 
+qint64 PdfPage::memoryUsage() const
+{
+    // Poppler keeps little more than the file, the rendered pages count
+    return QFileInfo(documentName).size() + d->loader.memoryUsage();
+}
+
 void PdfPage::showPageIndexInternal(int pageIndex)
 {
     showPage(pageIndex, QPointF(0,0));
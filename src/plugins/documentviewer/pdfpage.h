@@ -64,6 +64,9 @@ public:
 
     void showInfoBanner(const QString &message);
 
+    qint64 memoryUsage() const;
+    void saveReadingPosition();
+
 public slots:
     virtual void zoom(ZoomLevel level);
     virtual void searchText(DocumentPage::SearchMode mode,
@@ -143,6 +146,12 @@ protected slots:
      */
     virtual void updateRange();
 
+    /*!
+     * \brief Moves the view to the position stored when the document was
+     * closed last time
+     */
+    void restoreReadingPosition();
+
 protected:
     void showPageIndexInternal(int pageIndex);
     /*!
@@ -184,6 +193,7 @@ protected:
     virtual qreal pinchUpdated(qreal zoomFactor);
     virtual void pinchFinished(const QPointF &center, qreal scale);
     virtual QGraphicsWidget *pinchWidget();
+    virtual void addPluginActions();
 
     /*!
      * \brief Forces a point to be positive and not to exceed given maximum
@@ -201,6 +211,7 @@ private :
     void startSearch(const QString &searchText);
     qreal minimumZoomFactor() const;
     void stopSearchThreads();
+    qreal initialScale(int pageIndex, const ZoomLevel &level) const;
 
 private:
     class Private;
@@ -23,6 +23,9 @@
 #include "pdfloader.h"
 #include "applicationwindow.h"
 #include "actionpool.h"
+#include "tracepoint.h"
+#include "officelog.h"
+#include "perfcounters.h"
 
 const qreal PdfPageWidget::maximumScale = PdfLoader::DPIPerInch * MaxZoomFactor;
 
@@ -56,13 +59,13 @@ PdfPageWidget::~PdfPageWidget()
 
 void PdfPageWidget::update(const QRectF & rect)
 {
-    qDebug() << __PRETTY_FUNCTION__ << rect;
+    OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << rect;
     MWidget::update(rect);
 }
 
 void PdfPageWidget::updateupdate (qreal x, qreal y, qreal width, qreal height)
 {
-    qDebug() << __PRETTY_FUNCTION__ << x << y << width << height;
+    OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << x << y << width << height;
     MWidget::update(x, y, width, height);
 }
 
@@ -73,18 +76,23 @@ void PdfPageWidget::paint(QPainter *painter,
     Q_UNUSED(widget);
     QRectF expsRect = option->exposedRect;
 
+    TracePoint trace("paint", "render");
+    PerfTimer timer(PerfCounters::PdfPaintTime);
+    trace.setArgument("page", pageIndex);
+    loader->pagePainted(pageIndex);
+
     static int i = 0;
     if (++i % 10 == 0) {
-        qDebug() << "10";
+        OFFICE_LOG(Paint) << "10";
     }
     if ((!painter->clipRegion().isEmpty()) && (!painter->clipRegion().contains(expsRect.toRect()))) {
         return;
     }
-    qDebug() << __PRETTY_FUNCTION__ << painter->clipRegion().isEmpty() << painter->clipRegion().rects() << expsRect.toRect();
+    OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << painter->clipRegion().isEmpty() << painter->clipRegion().rects() << expsRect.toRect();
 
     if (m_cachedImage.isNull() || m_updateCachedImage) {
         QImage image = loader->getPageImage(pageIndex, scale, this);
-        qDebug() << __PRETTY_FUNCTION__ << "loader->getPageImage" << pageIndex << scale << image.isNull() << image.size();
+        OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << "loader->getPageImage" << pageIndex << scale << image.isNull() << image.size();
         if (!image.isNull()) {
             m_cachedImage = image;
             m_updateCachedImage = false;
@@ -92,7 +100,7 @@ void PdfPageWidget::paint(QPainter *painter,
     }
 
     if (m_cachedImage.isNull()) {
-        qDebug() << __PRETTY_FUNCTION__ << "show spinner" << pageIndex << scale;
+        OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << "show spinner" << pageIndex << scale;
         spinner->setPos(expsRect.center() - spinnerCenter);
         if(spinnerCenter.y() * 2 > expsRect.height()) {
             spinner->reset();
@@ -104,13 +112,13 @@ void PdfPageWidget::paint(QPainter *painter,
         }
     }
     else {
-        qDebug() << __PRETTY_FUNCTION__ << size() << m_cachedImage.size() << (size() == m_cachedImage.size());
+        OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << size() << m_cachedImage.size() << (size() == m_cachedImage.size());
         spinner->reset();
         spinner->setVisible(false);
         // there are some documents where the size() == m_cachedImage.size() does not work.
         // however the width seems to be always correct.
         if (m_cachedImage.size().width() == size().width()) {
-            qDebug() << __PRETTY_FUNCTION__ << "big as it should be" << pageIndex << scale;
+            OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << "big as it should be" << pageIndex << scale;
             // the different handling for bigger 2000 is needed as otherwise the quality is quite bad.
             if (m_cachedImage.height() > 2000 || m_cachedImage.width() > 2000) {
                 painter->drawImage(expsRect, m_cachedImage.copy(expsRect.toRect()));
@@ -122,7 +130,7 @@ void PdfPageWidget::paint(QPainter *painter,
         else {
             // only trigger update if we had not triggered before
             if (!m_updateCachedImage) {
-                qDebug() << __PRETTY_FUNCTION__ << "trigger update" << pageIndex << scale;
+                OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << "trigger update" << pageIndex << scale;
                 loader->getPageImage(pageIndex, scale, this);
                 m_updateCachedImage = true;
             }
@@ -130,7 +138,7 @@ void PdfPageWidget::paint(QPainter *painter,
             // zoom what we have at the moment to show until the update is done
             qreal zoom = m_cachedImage.size().width() / size().width();
             QRectF sourceRect(expsRect.topLeft() * zoom, expsRect.bottomRight() * zoom);
-            qDebug() << __PRETTY_FUNCTION__ << sourceRect << expsRect << zoom;
+            OFFICE_LOG(Paint) << __PRETTY_FUNCTION__ << sourceRect << expsRect << zoom;
             painter->drawImage(expsRect, m_cachedImage, sourceRect);
         }
     }
@@ -197,29 +205,13 @@ void PdfPageWidget::updateSize(const QSizeF & viewSize, const ZoomLevel & zoom)
         return;
     }
 
-    bool belowMinScale = false;
     QSize pageSize = loader->pageSize(pageIndex);
 
-    qreal newScale = zoomToScale(viewSize, zoom, pageSize);
-
-    qreal minScaleWidth = calcScale(viewSize.width(), pageSize.width());
-    qreal minScaleHeight = calcScale(viewSize.height(), pageSize.height());
-    qreal minScale = qMin(minScaleWidth, minScaleHeight);
-    //Minimum is fit to page or 100 % (the smaller one)
-    minScale = qMin(MinZoomFactor*PdfLoader::DPIPerInch, minScale);
+    qreal newScale = scaleForZoom(viewSize, zoom, pageSize, scale);
+    //Under the zoom out limit the minimum scale is only remembered
+    bool belowMinScale = newScale > zoomToScale(viewSize, zoom, pageSize, scale);
 
     if(zoom.isUserDefined()) {
-        if(newScale < minScale) {
-            //We are under zoom out limit so we set minimum scale
-            newScale =  minScale;
-            belowMinScale = true;
-            //this->updateSize(viewSize, ZoomLevel(ZoomLevel::FactorMode, minimumScaleFactor));
-        } else if(newScale > maximumScale) {
-            //We are over zoom in limit so we set maximum scale
-            newScale =  maximumScale;
-            //this->updateSize(viewSize, ZoomLevel(ZoomLevel::FactorMode, MaxZoomFactor));
-        }
-
         lastUserDefinedFactor = newScale / PdfLoader::DPIPerInch;
 
         if(pageIndex == loader->getCurrentPageIndex()) {
@@ -253,7 +245,26 @@ void PdfPageWidget::updateSize(const QSizeF & viewSize, const ZoomLevel & zoom)
     }
 }
 
-qreal PdfPageWidget::zoomToScale(const QSizeF & viewSize, const ZoomLevel & zoom, const QSize &pageSize)
+qreal PdfPageWidget::scaleForZoom(const QSizeF & viewSize, const ZoomLevel & zoom, const QSize &pageSize,
+                                  qreal currentScale)
+{
+    qreal newScale = zoomToScale(viewSize, zoom, pageSize, currentScale);
+
+    if(zoom.isUserDefined()) {
+        qreal minScaleWidth = calcScale(viewSize.width(), pageSize.width());
+        qreal minScaleHeight = calcScale(viewSize.height(), pageSize.height());
+        qreal minScale = qMin(minScaleWidth, minScaleHeight);
+        //Minimum is fit to page or 100 % (the smaller one)
+        minScale = qMin(MinZoomFactor*PdfLoader::DPIPerInch, minScale);
+
+        newScale = qBound(minScale, newScale, maximumScale);
+    }
+
+    return newScale;
+}
+
+qreal PdfPageWidget::zoomToScale(const QSizeF & viewSize, const ZoomLevel & zoom, const QSize &pageSize,
+                                 qreal currentScale)
 {
     qreal newScale = 0;
 
@@ -289,7 +300,7 @@ qreal PdfPageWidget::zoomToScale(const QSizeF & viewSize, const ZoomLevel & zoom
         qreal factor = 0;
 
         if(zoom.getFactor(factor)) {
-            newScale = scale*factor;
+            newScale = currentScale*factor;
         }
     }
 
@@ -72,6 +72,18 @@ public:
      */
     static qreal calcScaledSized(const qreal scale, const qreal size);
 
+    /*!
+     * \brief Calculate the 'poppler' scale a page gets with a zoom level,
+     * limited to the zoom range when the level is user defined
+     * \param viewSize is the scene visible size
+     * \param zoom is the zoom level
+     * \param pageSize is the size of the page in points
+     * \param currentScale is the scale relative zoom levels start from
+     * \return The scale
+     */
+    static qreal scaleForZoom(const QSizeF & viewSize, const ZoomLevel & zoom, const QSize &pageSize,
+                              qreal currentScale);
+
     /*!
      * \brief Checks if point in PDF is a link. Handles the link if it is.
      * \param point in the widget
@@ -114,7 +126,8 @@ protected:
 #ifdef SELECT_TEXT
     void calcTextBoxList(void);
 #endif
-    qreal zoomToScale(const QSizeF & viewSize, const ZoomLevel & zoom, const QSize &pageSize);
+    static qreal zoomToScale(const QSizeF & viewSize, const ZoomLevel & zoom, const QSize &pageSize,
+                             qreal currentScale);
 
 private slots:
     void clearCachedImage();
@@ -24,6 +24,8 @@
 #include <QDebug>
 
 #include "pdfsearch.h"
+#include "tracepoint.h"
+#include "perfcounters.h"
 
 #include <sys/time.h>
 
@@ -65,6 +67,7 @@ void PdfSearch::cancel()
 void PdfSearch::search()
 {
     qDebug() << "search";
+    TracePoint trace("search", "search");
     int pageIndex = m_currentPage;
     bool signalEmitted = false;
     bool hit = false;
@@ -106,6 +109,10 @@ void PdfSearch::searchPage(int pageIndex, bool &hit)
     double bottom = 0;
     double right = 0;
     double left = 0;
+    TracePoint trace("searchPage", "search");
+    trace.setArgument("page", pageIndex);
+    PerfTimer timer(PerfCounters::SearchTime);
+    PerfCounters::add(PerfCounters::SearchedPages);
     Poppler::Page *page = m_document->page(pageIndex);
 
     while(!m_canceled && page->search(m_searchText, left, top, right, bottom, Poppler::Page::NextResult, Poppler::Page::CaseInsensitive)) {
@@ -114,6 +121,7 @@ void PdfSearch::searchPage(int pageIndex, bool &hit)
 
         //Append the co-ordinates
         m_result[pageIndex].append(searchHit);
+        PerfCounters::add(PerfCounters::SearchHits);
 
         hit = true;
     }
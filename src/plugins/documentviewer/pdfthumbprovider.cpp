@@ -31,6 +31,7 @@
 #include "pdfthumbprovider.h"
 #include "misc.h"
 #include "applicationwindow.h"
+#include "officelog.h"
 
 class PdfThumbProvider::Private
 {
@@ -84,7 +85,7 @@ void PdfThumbProvider::paint(QPainter *painter, const QStyleOptionGraphicsItem *
             qreal pageWidth = data->loader->pageSize(pageIndex).width();
             qreal scale = PdfLoader::DPIPerInch * (thumbWidth / pageWidth);
 
-            qDebug() <<  __PRETTY_FUNCTION__ << "getThumbnail";
+            OFFICE_LOG(Thumbnail) <<  __PRETTY_FUNCTION__ << "getThumbnail";
             QImage thumb = data->loader->getThumbnail(pageIndex, scale);
             if (thumb.isNull()) {
                 widget->startSpinner(expsRect.center());
@@ -97,7 +98,7 @@ void PdfThumbProvider::paint(QPainter *painter, const QStyleOptionGraphicsItem *
             widget->stopSpinner();
         } else {
             if (thumbnail.width() != thumbWidth) {
-                qDebug() << "Thumbnail is scaled to Thumbnail widget ";
+                OFFICE_LOG(Thumbnail) << "Thumbnail is scaled to Thumbnail widget ";
                 thumbnail = thumbnail.scaledToWidth(thumbWidth);
                 QPixmapCache::replace(widget->key(), thumbnail);
                 m_lastThumbanailSize = QSizeF(thumbnail.size());
@@ -1,8 +1,9 @@
 //Include QT stuff
 #include <QDebug>
-#include <QMutex>
-#include <QTimer>
-#include <QCoreApplication>
+#include <QSet>
+#include <QtConcurrentMap>
+#include <QPainter>
+#include <QtAlgorithms>
 
 //Include Koffice stuff
 #include <Sheet.h>
@@ -11,78 +12,134 @@
 #include <Cell.h>
 #include <CellStorage.h>
 #include <tables/ui/SheetView.h>
+#include <tables/part/CanvasItem.h>
 #include <tables/RectStorage.h>
 #include <tables/ValueConverter.h>
 #include <tables/ValueStorage.h>
+#include <KoViewConverter.h>
 
 //Include application stuff
 #include "spreadsheetcommon.h"
 #include "definitions.h"
 
 
+namespace
+{
+
+/*!
+ * \brief Functor searching a sheet snapshot for QtConcurrent::mapped
+ */
+struct SnapshotSearch
+{
+    typedef QList<SheetResult> result_type;
+
+    SnapshotSearch(const QString &text)
+        : searchString(text)
+    {
+    }
+
+    QList<SheetResult> operator()(const SheetSnapshot &snapshot) const
+    {
+        return SpreadsheetSearch::searchSheet(snapshot, searchString);
+    }
+
+    QString searchString;
+};
+
+}
+
 SpreadsheetSearch::SpreadsheetSearch(SpreadsheetUtils *utils, Calligra::Tables::Doc *doc, int count)
     : spreadSheetUtils(utils)
     , spreadDoc(doc)
+    , currentSheetIndex(0)
     , slideCount(count)
+    , nextResult(0)
 
 {
     qDebug() << __PRETTY_FUNCTION__ ;
 
+    connect(&watcher, SIGNAL(resultReadyAt(int)), this, SLOT(sheetSearched(int)));
+    connect(&watcher, SIGNAL(finished()), this, SLOT(sheetsSearched()));
 }
 
 SpreadsheetSearch::~SpreadsheetSearch()
 {
     //qDebug() << __PRETTY_FUNCTION__;
+    cancel();
 }
 
-void SpreadsheetSearch::run()
+void SpreadsheetSearch::start()
 {
-    qDebug() << __PRETTY_FUNCTION__ ;
-    QTimer::singleShot(10, this, SLOT(startSearch()));
-    exec();
-}
+    cancel();
 
-void SpreadsheetSearch::startSearch()
-{
-    Calligra::Tables::Sheet* sheet = 0;
+    // the document is only read here on the GUI thread, the search threads
+    // only see the copies
     int index = currentSheetIndex;
 
-    while(index < slideCount) {
-        sheet = spreadDoc->map()->sheet(index);
-        int count = searchSheet(sheet, index);
+    for(int i = 0; i < slideCount; i++) {
+        Calligra::Tables::Sheet *sheet = spreadDoc->map()->sheet(index);
 
-        if(count > 0) {
-            emit setResults(index, count);
+        if(sheet) {
+            snapshots << snapshotSheet(sheet, index);
         }
 
-        index++;
+        //We reach the end of the document, we search from the beginning until we reach the current page.
+        index = (index + 1) % slideCount;
     }
 
-    //We reach the end of the document, we search from the beginning until we reach the current page.
-    index = 0;
+    watcher.setFuture(QtConcurrent::mapped(snapshots, SnapshotSearch(searchString)));
+}
 
-    while(index < currentSheetIndex) {
-        sheet = spreadDoc->map()->sheet(index);
-        int count = searchSheet(sheet, index);
+void SpreadsheetSearch::cancel()
+{
+    if(watcher.isRunning()) {
+        watcher.cancel();
+        watcher.waitForFinished();
+    }
+
+    snapshots.clear();
+    nextResult = 0;
+}
+
+bool SpreadsheetSearch::isRunning() const
+{
+    return watcher.isRunning();
+}
+
+void SpreadsheetSearch::sheetSearched(int index)
+{
+    Q_UNUSED(index);
 
-        if(count > 0) {
-            emit setResults(index, count);
+    // the sheets finish in any order, report them in the order they were
+    // started in
+    QFuture<QList<SheetResult> > future = watcher.future();
+
+    while(nextResult < snapshots.size() && future.isResultReadyAt(nextResult)) {
+        QList<SheetResult> results = future.resultAt(nextResult);
+        int sheetIndex = snapshots.at(nextResult).sheetIndex;
+        nextResult++;
+
+        if(results.size() > 0) {
+            sheetsResults.insert(sheetIndex, results);
+            emit setResults(sheetIndex, results.size());
         }
+    }
+}
 
-        index++;
+void SpreadsheetSearch::sheetsSearched()
+{
+    if(watcher.isCanceled()) {
+        return;
     }
 
+    sheetSearched(nextResult);
+    snapshots.clear();
+
     emit searchFinished();
 
     qDebug()<<"Run finish emit signal";
 }
 
-void SpreadsheetSearch::mSleep(unsigned long msecs)
-{
-    msleep(msecs);
-}
-
-
 void SpreadsheetSearch::setData(QString searchtext, int index)
 {
     searchString = searchtext;
@@ -95,48 +152,56 @@ static bool operator<(const SheetResult& a, const SheetResult& b) {
     return a.column < b.column;
 }
 
-int SpreadsheetSearch::searchSheet(Calligra::Tables::Sheet *sheet, int sheetIndex)
+SheetSnapshot SpreadsheetSearch::snapshotSheet(Calligra::Tables::Sheet *sheet, int sheetIndex)
 {
-    Q_UNUSED(sheetIndex);
-    qDebug() << __PRETTY_FUNCTION__;
-    QList<SheetResult> searchResults;
-    Calligra::Tables::CellStorage *storage = sheet->cellStorage();
+    SheetSnapshot snapshot;
+    snapshot.sheetIndex = sheetIndex;
+    Calligra::Tables::CellStorage *storage = sheet ? sheet->cellStorage() : 0;
 
-    if((0 == sheet) || (0 == storage)) {
-        return 0;
+    if(0 == storage) {
+        return snapshot;
     }
 
-    // collect points in a set to eliminate duplicates for cells that match multiple criteria
-    QSet<QPoint> resultPositions;
-    // first search through values
+    // first the values
     Calligra::Tables::ValueConverter* converter = sheet->map()->converter();
     const Calligra::Tables::ValueStorage* values = storage->valueStorage();
     for (int i = 0; i < values->count(); ++i) {
-        if (converter->asString(values->data(i)).asString().contains(searchString, Qt::CaseInsensitive)) {
-            resultPositions.insert(QPoint(values->col(i), values->row(i)));
-        }
+        snapshot.positions << QPoint(values->col(i), values->row(i));
+        snapshot.texts << converter->asString(values->data(i)).asString();
     }
-    // next search through userinput
+    // next the userinput
     const Calligra::Tables::UserInputStorage* userInput = storage->userInputStorage();
     for (int i = 0; i < userInput->count(); ++i) {
-        if (userInput->data(i).contains(searchString, Qt::CaseInsensitive)) {
-            resultPositions.insert(QPoint(userInput->col(i), userInput->row(i)));
-        }
+        snapshot.positions << QPoint(userInput->col(i), userInput->row(i));
+        snapshot.texts << userInput->data(i);
     }
-    // next search through comments
+    // next the comments
     const Calligra::Tables::CommentStorage* commentStorage = storage->commentStorage();
     QList<QPair<QRectF, QString> > comments = commentStorage->intersectingPairs(Calligra::Tables::Region(QRect(0, 0, KS_colMax, KS_rowMax), sheet));
     typedef QPair<QRectF, QString> RectStringPair;
     foreach (const RectStringPair& p, comments) {
-        if (p.second.contains(searchString, Qt::CaseInsensitive)) {
-            resultPositions.insert(p.first.topLeft().toPoint());
-        }
+        snapshot.positions << p.first.topLeft().toPoint();
+        snapshot.texts << p.second;
     }
-    // finally search through links
+    // finally the links
     const Calligra::Tables::LinkStorage* links = storage->linkStorage();
     for (int i = 0; i < links->count(); ++i) {
-        if (links->data(i).contains(searchString, Qt::CaseInsensitive)) {
-            resultPositions.insert(QPoint(links->col(i), links->row(i)));
+        snapshot.positions << QPoint(links->col(i), links->row(i));
+        snapshot.texts << links->data(i);
+    }
+
+    return snapshot;
+}
+
+QList<SheetResult> SpreadsheetSearch::searchSheet(const SheetSnapshot &snapshot, const QString &searchString)
+{
+    QList<SheetResult> searchResults;
+
+    // collect points in a set to eliminate duplicates for cells that match multiple criteria
+    QSet<QPoint> resultPositions;
+    for (int i = 0; i < snapshot.texts.size(); ++i) {
+        if (snapshot.texts.at(i).contains(searchString, Qt::CaseInsensitive)) {
+            resultPositions.insert(snapshot.positions.at(i));
         }
     }
 
@@ -145,173 +210,24 @@ int SpreadsheetSearch::searchSheet(Calligra::Tables::Sheet *sheet, int sheetInde
         SheetResult result;
         result.row = p.y();
         result.column = p.x();
-        qDebug() << "+++++++++++++++++  Searched string found in at >> " << result.row << result.column;
-        result.background = Calligra::Tables::Cell(sheet, result.column, result.row).style().backgroundColor();
         searchResults << result;
     }
 
     // and sort the list of search results (a QSet is not sorted)
     qSort(searchResults);
 
-    if(searchResults.size() > 0) {
-        searchLock.lockForWrite();
-        sheetsResults.insert(sheetIndex, searchResults);
-        searchLock.unlock();
-    }
-
-    qDebug()<<"++++++++++++++++ sheetsearch Finish";
-
-    return searchResults.size();
+    return searchResults;
 }
 
-void SpreadsheetSearch::clearResults(int currentSheetIndex)
+void SpreadsheetSearch::clearResults()
 {
-
-    Calligra::Tables::Sheet* sheet = 0;
-
-    //Getting Read lock on sheet.
-    bool lockResult = searchLock.tryLockForRead();
-
-    sheet = spreadDoc->map()->sheet(currentSheetIndex);
-    QList<SheetResult> sheetResults = sheetsResults.value(currentSheetIndex);
-
-    foreach(SheetResult result, sheetResults) {
-        setCellBackground(sheet,
-                          result.row,
-                          result.column,
-                          result.background);
-    }
-
+    cancel();
     sheetsResults.clear();
-
-    //Unlocking
-
-    if(true == lockResult) {
-        searchLock.unlock();
-    }
 }
 
-void SpreadsheetSearch::setCellBackground(Calligra::Tables::Sheet* sheet,
-                                          int row,
-                                          int column,
-                                          const QColor &color)
+QList<SheetResult> SpreadsheetSearch::sheetResults(int sheetIndex) const
 {
-    Calligra::Tables::CellStorage *storage = 0;
-
-    if(0 != sheet && 0 != (storage = sheet->cellStorage())) {
-        Calligra::Tables::Region region(QPoint(column, row), sheet);
-
-        Calligra::Tables::Style style = storage->style(column, row);
-        style.setBackgroundColor(color);
-        storage->setStyle(region, style);
-    }
-}
-
-void SpreadsheetSearch::setWordsColor(Calligra::Tables::Sheet* currentSheet, int currentSheetIndex, int currentIndex)
-{
-    if(!currentSheet || (currentIndex < 0)) {
-        return;
-    }
-
-    //Getting Read lock on sheet.
-    bool lockResult = searchLock.tryLockForRead();
-
-    QList<SheetResult> sheetResults = sheetsResults.value(currentSheetIndex);
-
-    if((currentIndex > 0) && (currentIndex < sheetResults.size())) {
-        setCellBackground(currentSheet,
-                          sheetResults[currentIndex - 1].row,
-                          sheetResults[currentIndex - 1].column,
-                          highlightColor);
-    } else if((currentIndex == 0) && (currentIndex < sheetResults.size())) {
-        setCellBackground(currentSheet,
-                          sheetResults[sheetResults.size() - 1].row,
-                          sheetResults[sheetResults.size() - 1].column,
-                          highlightColor);
-    }
-
-    setCellBackground(currentSheet,
-
-                      sheetResults[currentIndex].row,
-                      sheetResults[currentIndex].column,
-                      highlightColorCurrent);
-
-    if((currentIndex >= 0) && (currentIndex < (sheetResults.size() -1))) {
-        setCellBackground(currentSheet,
-                          sheetResults[currentIndex + 1].row,
-                          sheetResults[currentIndex + 1].column,
-                          highlightColor);
-    } else if((currentIndex > 0) && (currentIndex == sheetResults.size() - 1)) {
-        setCellBackground(currentSheet,
-                          sheetResults[0].row,
-                          sheetResults[0].column,
-                          highlightColor);
-    }
-
-    //Unlocking
-    if(true == lockResult) {
-        searchLock.unlock();
-    }
-
-}
-
-void SpreadsheetSearch::highlightSheetResult(Calligra::Tables::Sheet* sheet, int sheetIndex, int currentIndex)
-{
-    qDebug() << __PRETTY_FUNCTION__ ;
-
-    if(!sheet) {
-        return;
-    }
-
-    //Getting Read lock on sheet.
-    bool lockResult = searchLock.tryLockForRead();
-
-    QList<SheetResult> sheetResults = sheetsResults.value(sheetIndex);
-
-    //Unlocking
-    if(true == lockResult) {
-        searchLock.unlock();
-    }
-
-    if(sheetResults.size() < 500) {
-        for(int i = 0; i < sheetResults.size(); i++) {
-            if(i == currentIndex) {
-                setCellBackground(sheet,
-                                  sheetResults[i].row,
-                                  sheetResults[i].column,
-                                  highlightColorCurrent);
-            } else {
-                setCellBackground(sheet,
-                                  sheetResults[i].row,
-                                  sheetResults[i].column,
-                                  highlightColor);
-            }
-        }
-    } else {
-        if(currentIndex < 0) {
-            return;
-        }
-
-        if((currentIndex > 0) && (currentIndex < sheetResults.size())) {
-            setCellBackground(sheet,
-                              sheetResults[currentIndex - 1].row,
-                              sheetResults[currentIndex - 1].column,
-                              highlightColor);
-        }
-
-        setCellBackground(sheet,
-
-                          sheetResults[currentIndex].row,
-                          sheetResults[currentIndex].column,
-                          highlightColorCurrent);
-
-        if((currentIndex >= 0) && (currentIndex < (sheetResults.size() -1))) {
-            setCellBackground(sheet,
-                              sheetResults[currentIndex + 1].row,
-                              sheetResults[currentIndex + 1].column,
-                              highlightColor);
-        }
-    }
+    return sheetsResults.value(sheetIndex);
 }
 
 QRectF SpreadsheetSearch::mapSearchResult(Calligra::Tables::Sheet* sheet, int sheetIndex, int currentIndex)
@@ -319,17 +235,8 @@ QRectF SpreadsheetSearch::mapSearchResult(Calligra::Tables::Sheet* sheet, int sh
     QRectF rect;
 
     if(sheet) {
-        //Getting Read lock on sheet.
-        bool lockResult = searchLock.tryLockForRead();
-
         QList<SheetResult> sheetResults = sheetsResults.value(sheetIndex);
 
-        // Unlocking lock
-
-        if(true == lockResult) {
-            searchLock.unlock();
-        }
-
         if(0 <= currentIndex && currentIndex < sheetResults.size()) {
             QRect cell(sheetResults[currentIndex].column, sheetResults[currentIndex].row, 1, 1);
 
@@ -345,6 +252,72 @@ QRectF SpreadsheetSearch::mapSearchResult(Calligra::Tables::Sheet* sheet, int sh
 }
 
 
+SpreadsheetSearchOverlay::SpreadsheetSearchOverlay(Calligra::Tables::CanvasItem *canvas)
+    : QGraphicsItem(canvas)
+    , m_canvas(canvas)
+    , m_sheet(0)
+    , m_currentIndex(-1)
+{
+    setFlag(QGraphicsItem::ItemIgnoresParentOpacity);
+    setAcceptedMouseButtons(Qt::NoButton);
+}
+
+void SpreadsheetSearchOverlay::setResults(Calligra::Tables::Sheet *sheet, const QList<SheetResult> &results, int currentIndex)
+{
+    prepareGeometryChange();
+    m_sheet = sheet;
+    m_results = results;
+    m_currentIndex = currentIndex;
+    update();
+}
+
+void SpreadsheetSearchOverlay::clear()
+{
+    setResults(0, QList<SheetResult>(), -1);
+}
+
+QRectF SpreadsheetSearchOverlay::boundingRect() const
+{
+    return m_canvas->boundingRect();
+}
+
+void SpreadsheetSearchOverlay::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    if (!m_sheet || m_results.isEmpty()) {
+        return;
+    }
+
+    const KoViewConverter *converter = m_canvas->viewConverter();
+    const QPointF offset = m_canvas->offset();
+    const QRectF visible = converter->viewToDocument(boundingRect()).translated(offset);
+
+    // the results are sorted by row so only the visible rows are looked at
+    qreal top;
+    SheetResult first;
+    first.row = m_sheet->topRow(visible.top(), top);
+    first.column = 0;
+    const int lastRow = m_sheet->bottomRow(visible.bottom());
+
+    QColor color(highlightColor);
+    color.setAlpha(SearchHighlightAlpha);
+    QColor currentColor(highlightColorCurrent);
+    currentColor.setAlpha(SearchHighlightAlpha);
+
+    QList<SheetResult>::const_iterator begin = m_results.constBegin();
+    QList<SheetResult>::const_iterator it = qLowerBound(begin, m_results.constEnd(), first);
+    for (; it != m_results.constEnd() && it->row <= lastRow; ++it) {
+        QRectF cell = m_sheet->cellCoordinatesToDocument(QRect(it->column, it->row, 1, 1));
+        if (!cell.intersects(visible)) {
+            continue;
+        }
+        QRectF rect = converter->documentToView(cell.translated(-offset));
+        painter->fillRect(rect, (it - begin) == m_currentIndex ? currentColor : color);
+    }
+}
+
 SpreadsheetUtils::SpreadsheetUtils()
 {
 }
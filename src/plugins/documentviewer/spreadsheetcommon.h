@@ -1,9 +1,14 @@
 #ifndef SPREADSHEETCOMMON_H
 #define SPREADSHEETCOMMON_H
 
-#include <QThread>
+#include <QObject>
 #include <QMap>
-#include <QReadWriteLock>
+#include <QList>
+#include <QVector>
+#include <QPoint>
+#include <QStringList>
+#include <QFutureWatcher>
+#include <QGraphicsItem>
 #include <QColor>
 #include <QRectF>
 #include <QSizeF>
@@ -22,6 +27,8 @@ class View;
 
 class Cell;
 
+class CanvasItem;
+
 class Sheet;
 
 class SheetView;
@@ -37,16 +44,30 @@ class SheetView;
 typedef struct {
     int     row;
     int     column;
-    QColor  background;
 } SheetResult;
 
+/*!
+ * \typedef SheetSnapshot
+ * \brief The texts of a sheet copied for searching them outside the GUI
+ * thread. The position of the cell of texts[i] is positions[i].
+ */
+
+typedef struct {
+    int             sheetIndex;
+    QVector<QPoint> positions;
+    QStringList     texts;
+} SheetSnapshot;
+
 /*!
  * \class SpreadsheetSearch
  * \brief The class provides search for spreadsheet
  *
+ * The texts of the sheets are copied on the GUI thread when the search is
+ * started and the sheets are then searched in parallel. The results are
+ * reported in sheet order starting from the current sheet.
  */
 
-class DOCUMENTVIEWER_EXPORT SpreadsheetSearch : public QThread
+class DOCUMENTVIEWER_EXPORT SpreadsheetSearch : public QObject
 {
     Q_OBJECT
 
@@ -79,27 +100,33 @@ public:
     virtual ~SpreadsheetSearch();
 
     /*!
-     * \brief Search given string from the sheet and appeds it
-     * to existsing search result (does not clear or highlight the view).
-     * \param sheet to be searched
-     * \param sheetindex to store the result
-     * \returns None
+     * \brief Copies the texts of a sheet for searching
+     * \param sheet to be copied
+     * \param sheetIndex is the index of the sheet
+     * \returns the texts of the sheet
      */
-    int searchSheet(Calligra::Tables::Sheet* sheet, int sheetIndex);
+    static SheetSnapshot snapshotSheet(Calligra::Tables::Sheet *sheet, int sheetIndex);
 
     /*!
-     * \brief Clears both search result and highlighting for sheet.
+     * \brief Search given string from the texts of a sheet. Safe to be
+     * called from any thread.
+     * \param snapshot is the copy of the sheet to be searched
+     * \param searchString is the text to search for
+     * \returns the cells having the text sorted by row and column
      */
-    void clearResults(int sheetIndex);
+    static QList<SheetResult> searchSheet(const SheetSnapshot &snapshot, const QString &searchString);
 
     /*!
-     * \brief Highlighs text found in #search call.
-     * \param sheet to be searched
-     * \param sheetindex to store the result
-     * \param currentIndex is the index of current highlighing. The -1 indicates
-     * that current is not in this sheet
+     * \brief Stops the search and clears the search results of all sheets.
      */
-    void highlightSheetResult(Calligra::Tables::Sheet* sheet, int sheetIndex, int currentIndex);
+    void clearResults();
+
+    /*!
+     * \brief Gets the search results of a sheet
+     * \param sheetIndex is the index of the sheet
+     * \returns the cells having the searched text sorted by row and column
+     */
+    QList<SheetResult> sheetResults(int sheetIndex) const;
 
     /*!
      * \brief Gets area of given search index
@@ -111,53 +138,33 @@ public:
     QRectF mapSearchResult(Calligra::Tables::Sheet* sheet, int sheetIndex, int currentIndex);
 
     /*!
-     * \brief Overriding QThread run method.
+     * \brief To set the search data which gonna be used
+     * \param searchtext is the text to search for
+     * \param index is the sheet to start the search from
      */
-    virtual void run();
+    void setData(QString searchtext, int index);
 
     /*!
-     * \brief To set the thread data which gonna be used
-     * \param
-     * \param
-     * \param
-     * \returns None
+     * \brief Copies the sheets and starts searching them
      */
-    void setData(QString searchtext, int index);
+    void start();
 
     /*!
-     * \brief To put in sleep for mili second.
+     * \brief Stops a running search, results not reported yet are dropped
      */
-    void mSleep(unsigned long msecs);
+    void cancel();
 
     /*!
-     * \brief Sets background color as per the position given
-     * \param currentSheet- Sheet which we have to highlight current result.
-     * \param currentSheetIndex - SheetIndex.
-     * \param currentWordIndex - Current Word index to which we have to highlight.
+     * \returns true if a search is running
      */
-    void setWordsColor(Calligra::Tables::Sheet* currentSheet, int currentSheetIndex, int currentWordIndex);
+    bool isRunning() const;
 
 private slots:
-    void startSearch();
-
-protected:
-
-    /*!
-     * \brief Sets background color of given cell
-     * \param sheet to be searched
-     * \param row is the row of the cell
-     * \param column is the column of the cell
-     * \param color is the new background color of the cell
-     */
-    void setCellBackground(Calligra::Tables::Sheet* sheet, int row, int column, const QColor &color);
+    void sheetSearched(int index);
+    void sheetsSearched();
 
 private:
 
-    /*!
-    * \brief ReaderWriter lock
-    */
-    mutable QReadWriteLock    searchLock;
-
     /*!
     * \brief List of cells that have the searched text
     */
@@ -188,6 +195,52 @@ private:
     */
     int slideCount;
 
+    /*!
+    * \brief The sheets being searched, in the order of the results
+    */
+    QList<SheetSnapshot> snapshots;
+
+    /*!
+    * \brief Index of the next result to be reported
+    */
+    int nextResult;
+
+    QFutureWatcher<QList<SheetResult> > watcher;
+};
+
+/*!
+ * \class SpreadsheetSearchOverlay
+ * \brief Draws the search results of the active sheet on top of the sheet
+ * canvas without touching the styles of the document
+ */
+
+class SpreadsheetSearchOverlay : public QGraphicsItem
+{
+public:
+    SpreadsheetSearchOverlay(Calligra::Tables::CanvasItem *canvas);
+
+    /*!
+     * \brief Sets the search results to be drawn
+     * \param sheet is the sheet the results are in
+     * \param results are the results sorted by row and column
+     * \param currentIndex is the index of the current result, -1 if the
+     * current result is not in this sheet
+     */
+    void setResults(Calligra::Tables::Sheet *sheet, const QList<SheetResult> &results, int currentIndex);
+
+    /*!
+     * \brief Removes all search results
+     */
+    void clear();
+
+    QRectF boundingRect() const;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
+
+private:
+    Calligra::Tables::CanvasItem *m_canvas;
+    Calligra::Tables::Sheet *m_sheet;
+    QList<SheetResult> m_results;
+    int m_currentIndex;
 };
 
 class SpreadsheetUtils
@@ -0,0 +1,158 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include "thumbnailcache.h"
+
+#include <QTime>
+
+#include "definitions.h"
+
+ThumbnailCache::ThumbnailCache(ThumbnailRenderer *renderer, QObject *parent)
+    : QObject(parent)
+    , m_renderer(renderer)
+    , m_thumbnails(ThumbnailCacheBudget)
+    , m_prefetchPage(0)
+    , m_lastCost(0)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(renderThumbnails()));
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    stop();
+}
+
+QImage ThumbnailCache::thumbnail(int page)
+{
+    m_lastRequest.start();
+
+    if (QImage *image = m_thumbnails.object(page)) {
+        PerfCounters::add(PerfCounters::CacheHits);
+        return *image;
+    }
+    PerfCounters::add(PerfCounters::CacheMisses);
+
+    if (!m_queue.contains(page)) {
+        m_queue.append(page);
+        PerfCounters::add(PerfCounters::RenderQueueDepth);
+    }
+    if (!m_timer.isActive()) {
+        m_timer.start(0);
+    }
+    return QImage();
+}
+
+QImage ThumbnailCache::renderedThumbnail(int page)
+{
+    if (QImage *image = m_thumbnails.object(page)) {
+        PerfCounters::add(PerfCounters::CacheHits);
+        return *image;
+    }
+    PerfCounters::add(PerfCounters::CacheMisses);
+
+    QImage image = m_renderer->renderThumbnail(page);
+    insert(page, image);
+    return image;
+}
+
+void ThumbnailCache::remove(int page)
+{
+    if (m_thumbnails.remove(page)) {
+        // render it again with the prefetched pages
+        m_prefetchPage = qMin(m_prefetchPage, page);
+        if (!m_timer.isActive()) {
+            m_timer.start(0);
+        }
+    }
+}
+
+void ThumbnailCache::stop()
+{
+    m_timer.stop();
+    PerfCounters::add(PerfCounters::RenderQueueDepth, -m_queue.count());
+    m_queue.clear();
+    m_lastRequest = QTime();
+}
+
+void ThumbnailCache::renderThumbnails()
+{
+    if (!m_renderer->canRenderThumbnails()) {
+        m_timer.start(ThumbnailLayoutWait);
+        return;
+    }
+
+    QTime slice;
+    slice.start();
+    do {
+        const int page = nextPage();
+        if (page < 0) {
+            return;
+        }
+
+        QImage image = m_renderer->renderThumbnail(page);
+        if (!image.isNull()) {
+            insert(page, image);
+            emit thumbnailReady(page);
+        }
+    } while (slice.elapsed() < ThumbnailTimeSlice);
+
+    // let the events in before going on
+    m_timer.start(0);
+}
+
+int ThumbnailCache::nextPage()
+{
+    while (!m_queue.isEmpty()) {
+        const int page = m_queue.takeFirst();
+        PerfCounters::add(PerfCounters::RenderQueueDepth, -1);
+        if (!m_thumbnails.contains(page)) {
+            return page;
+        }
+    }
+
+    // prefetch only while the all pages view keeps asking for thumbnails
+    // and the cache does not have to drop anything
+    if (m_lastRequest.isNull() || m_lastRequest.elapsed() > ThumbnailPrefetchWindow) {
+        return -1;
+    }
+
+    const int count = m_renderer->thumbnailCount();
+    while (m_prefetchPage < count
+           && m_thumbnails.totalCost() + m_lastCost <= m_thumbnails.maxCost()) {
+        const int page = m_prefetchPage++;
+        if (!m_thumbnails.contains(page)) {
+            return page;
+        }
+    }
+    return -1;
+}
+
+void ThumbnailCache::insert(int page, const QImage &image)
+{
+    if (image.isNull()) {
+        return;
+    }
+    m_lastCost = image.byteCount();
+    m_thumbnails.insert(page, new QImage(image), m_lastCost);
+}
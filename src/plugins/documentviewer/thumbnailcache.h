@@ -0,0 +1,126 @@
+/*
+ * This file is part of Meego Office UI for KOffice
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: Suresh Chande suresh.chande@nokia.com
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QObject>
+#include <QImage>
+#include <QTime>
+#include <QTimer>
+
+#include "perfcounters.h"
+
+/*!
+ * \class ThumbnailRenderer
+ * \brief Renders the thumbnails of a #ThumbnailCache
+ */
+class ThumbnailRenderer
+{
+public:
+    virtual ~ThumbnailRenderer() {}
+
+    virtual int thumbnailCount() = 0;
+
+    /*!
+     * \brief False while the document is not ready for thumbnails, e.g.
+     * because it has not been laid out yet
+     */
+    virtual bool canRenderThumbnails() = 0;
+
+    /*!
+     * \return The thumbnail or a null image if the page can not be rendered
+     */
+    virtual QImage renderThumbnail(int page) = 0;
+};
+
+/*!
+ * \class ThumbnailCache
+ * \brief Renders thumbnails in idle time and keeps them within
+ * ThumbnailCacheBudget bytes.
+ *
+ * The pages asked for are rendered first. While the all pages view keeps
+ * asking, the following pages are prefetched as long as they fit in the
+ * cache.
+ */
+class ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    ThumbnailCache(ThumbnailRenderer *renderer, QObject *parent = 0);
+    ~ThumbnailCache();
+
+    /*!
+     * \brief Gets a thumbnail without blocking
+     * \return the thumbnail, or a null image in which case the page is
+     * queued and #thumbnailReady is emitted once it is rendered
+     */
+    QImage thumbnail(int page);
+
+    /*!
+     * \brief Gets a thumbnail, rendering it right away if it is not cached
+     */
+    QImage renderedThumbnail(int page);
+
+    /*!
+     * \brief Drops the thumbnail of a changed page
+     */
+    void remove(int page);
+
+    /*!
+     * \brief Stops rendering, e.g. before the document is deleted
+     */
+    void stop();
+
+signals:
+    void thumbnailReady(int page);
+
+private slots:
+    /*!
+     * \brief Renders queued thumbnails for ThumbnailTimeSlice milliseconds
+     */
+    void renderThumbnails();
+
+private:
+    /*!
+     * \brief The next page to render a thumbnail for
+     * \return the page index or -1 if there is nothing left to do
+     */
+    int nextPage();
+    void insert(int page, const QImage &image);
+
+    ThumbnailRenderer *m_renderer;
+    //! Thumbnails by page index, the cost is the size in bytes
+    CountedCache<int, QImage> m_thumbnails;
+    //! Pages asked for by the all pages view
+    QList<int> m_queue;
+    //! Next page rendered when the queue is empty
+    int m_prefetchPage;
+    int m_lastCost;
+    //! When the all pages view last asked for a thumbnail
+    QTime m_lastRequest;
+    QTimer m_timer;
+};
+
+#endif // THUMBNAILCACHE_H
@@ -13,7 +13,10 @@ SUBDIRS     =   \
     ut_basepagewidget \
     ut_actionpool \
     ut_pdfthumbprovider \
-    ut_spreadsheet
+    ut_spreadsheet \
+    ut_documentfilterindex \
+    ut_instanceregistry \
+    ut_perfcounters
 	
 tests.path = /usr/share/office-tools-tests
 tests.files = tests.xml
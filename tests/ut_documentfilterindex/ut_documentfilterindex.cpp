@@ -0,0 +1,79 @@
+#include <QCoreApplication>
+#include <QDebug>
+
+#include "ut_documentfilterindex.h"
+
+void Ut_DocumentFilterIndex::init()
+{
+    index = new DocumentFilterIndex();
+    index->insert("urn:1", "Annual report\nPDF");
+    index->insert("urn:2", "Report draft\nWord document");
+    index->insert("urn:3", "Budget\nSpreadsheet");
+}
+
+void Ut_DocumentFilterIndex::cleanup()
+{
+    delete index;
+    index = 0;
+}
+
+void Ut_DocumentFilterIndex::testMatch()
+{
+    const struct testStruct {
+        const char *filter;
+        int count;
+    } testData[] = {
+
+        {  "", 3 }
+        ,{ "r", 3 }
+        ,{ "re", 3 }
+        ,{ "REP", 2 }
+        ,{ "report", 2 }
+        ,{ "annual report", 1 }
+        ,{ "ortrep", 0 }
+        ,{ "spreadsheet", 1 }
+        ,{ "xyz", 0 }
+    };
+
+    for(unsigned int i = 0; i < (sizeof(testData) / sizeof testData[0]); i++) {
+        QSet<QString> result = index->match(testData[i].filter);
+        //qDebug() << __PRETTY_FUNCTION__ << testData[i].filter << result;
+        QCOMPARE(result.count(), testData[i].count);
+    }
+
+    QVERIFY(index->match("budget").contains("urn:3"));
+}
+
+void Ut_DocumentFilterIndex::testUpdate()
+{
+    index->insert("urn:3", "Budget report\nSpreadsheet");
+
+    QCOMPARE(index->count(), 3);
+    QCOMPARE(index->match("report").count(), 3);
+
+    index->insert("urn:3", "Budget\nSpreadsheet");
+
+    QCOMPARE(index->match("report").count(), 2);
+}
+
+void Ut_DocumentFilterIndex::testRemove()
+{
+    index->remove("urn:2");
+
+    QVERIFY(!index->contains("urn:2"));
+    QCOMPARE(index->count(), 2);
+    QCOMPARE(index->match("report").count(), 1);
+    QCOMPARE(index->match("wor").count(), 0);
+
+    index->clear();
+
+    QCOMPARE(index->count(), 0);
+    QCOMPARE(index->match("").count(), 0);
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    Ut_DocumentFilterIndex test;
+    return QTest::qExec(&test, argc, argv);
+}
@@ -0,0 +1,25 @@
+#ifndef UT_DOCUMENTFILTERINDEX_H
+#define UT_DOCUMENTFILTERINDEX_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+
+#include "documentfilterindex.h"
+
+class Ut_DocumentFilterIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testMatch();
+    void testUpdate();
+    void testRemove();
+
+private:
+    DocumentFilterIndex *index;
+};
+
+#endif // UT_DOCUMENTFILTERINDEX_H
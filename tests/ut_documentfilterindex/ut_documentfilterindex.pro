@@ -0,0 +1,4 @@
+include(../common_head.pri)
+
+SOURCES += ut_documentfilterindex.cpp
+HEADERS += ut_documentfilterindex.h
@@ -0,0 +1,56 @@
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <unistd.h>
+
+#include "ut_instanceregistry.h"
+#include "instanceregistry.h"
+
+namespace
+{
+    const char DocumentA[] = "/home/user/MyDocs/a.pdf";
+    const char DocumentB[] = "/home/user/MyDocs/b.odt";
+}
+
+void Ut_InstanceRegistry::cleanup()
+{
+    InstanceRegistry &registry = InstanceRegistry::instance();
+    registry.remove(InstanceRegistry::Document, DocumentA);
+    registry.remove(InstanceRegistry::Document, DocumentB);
+    registry.remove(InstanceRegistry::FrontPage);
+}
+
+void Ut_InstanceRegistry::testFind()
+{
+    InstanceRegistry &registry = InstanceRegistry::instance();
+
+    QCOMPARE(registry.find(InstanceRegistry::Document, DocumentA), pid_t(0));
+
+    registry.add(InstanceRegistry::Document, DocumentA);
+    registry.add(InstanceRegistry::FrontPage);
+
+    QCOMPARE(registry.find(InstanceRegistry::Document, DocumentA), getpid());
+    QCOMPARE(registry.find(InstanceRegistry::Document, DocumentB), pid_t(0));
+    QCOMPARE(registry.find(InstanceRegistry::FrontPage), getpid());
+    QCOMPARE(registry.find(InstanceRegistry::FrontPage, DocumentA), pid_t(0));
+}
+
+void Ut_InstanceRegistry::testRemove()
+{
+    InstanceRegistry &registry = InstanceRegistry::instance();
+
+    registry.add(InstanceRegistry::Document, DocumentA);
+    registry.add(InstanceRegistry::Document, DocumentA);
+    registry.add(InstanceRegistry::Document, DocumentB);
+    registry.remove(InstanceRegistry::Document, DocumentA);
+
+    QCOMPARE(registry.find(InstanceRegistry::Document, DocumentA), pid_t(0));
+    QCOMPARE(registry.find(InstanceRegistry::Document, DocumentB), getpid());
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    Ut_InstanceRegistry test;
+    return QTest::qExec(&test, argc, argv);
+}
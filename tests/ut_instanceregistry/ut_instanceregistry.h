@@ -0,0 +1,18 @@
+#ifndef UT_INSTANCEREGISTRY_H
+#define UT_INSTANCEREGISTRY_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+
+class Ut_InstanceRegistry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+
+    void testFind();
+    void testRemove();
+};
+
+#endif // UT_INSTANCEREGISTRY_H
@@ -0,0 +1,4 @@
+include(../common_head.pri)
+
+SOURCES += ut_instanceregistry.cpp
+HEADERS += ut_instanceregistry.h
@@ -193,6 +193,16 @@ void Ut_misc::testgetFileTypeFromFile()
     QCOMPARE(QString("qtn_comm_filetype_ods"), Misc::getFileTypeFromFile("/usr/share/office-tools-tests/data/spreadsheet.ods"));
 }
 
+void Ut_misc::testgetFileTypeFromMime()
+{
+    QCOMPARE(Misc::getFileTypeFromMime("application/msword"), QString("qtn_comm_filetype_doc"));
+    QCOMPARE(Misc::getFileTypeFromMime("application/vnd.ms-powerpoint"), QString("qtn_comm_filetype_ppt"));
+    QCOMPARE(Misc::getFileTypeFromMime("application/vnd.ms-powerpoint", "pps"), QString("qtn_comm_filetype_pps"));
+    QCOMPARE(Misc::getFileTypeFromMime("application/vnd.oasis.opendocument.presentation-template"), QString("qtn_comm_filetype_odp"));
+    QCOMPARE(Misc::getFileTypeFromMime("application/vnd.ms-excel.sheet.macroEnabled.12"), QString());
+    QCOMPARE(Misc::getFileTypeFromMime("image/png"), QString());
+}
+
 int main(int argc, char* argv[])
 {
     QCoreApplication app(argc, argv);
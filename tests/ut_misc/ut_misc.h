@@ -24,6 +24,7 @@ private slots:
     void testtranslateRelativeRect();
     void testgetMaxSizeInGivenSize();
     void testgetFileTypeFromFile();
+    void testgetFileTypeFromMime();
 };
 
 #endif //UT__MISC_H
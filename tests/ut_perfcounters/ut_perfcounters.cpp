@@ -0,0 +1,70 @@
+#include <QCoreApplication>
+#include <QDebug>
+
+#include "ut_perfcounters.h"
+#include "perfcounters.h"
+
+void Ut_PerfCounters::init()
+{
+    // reset() keeps the current cache size and queue depth
+    PerfCounters::set(PerfCounters::CacheBytes, 0);
+    PerfCounters::set(PerfCounters::RenderQueueDepth, 0);
+    PerfCounters::reset();
+}
+
+void Ut_PerfCounters::testCounters()
+{
+    PerfCounters::add(PerfCounters::CacheEvictions);
+    PerfCounters::add(PerfCounters::CacheEvictions, 2);
+    PerfCounters::add(PerfCounters::CacheBytes, 1000);
+    PerfCounters::add(PerfCounters::CacheBytes, -400);
+    PerfCounters::set(PerfCounters::RenderQueueDepth, 3);
+    PerfCounters::set(PerfCounters::RenderQueueDepth, 1);
+
+    const QVariantMap values = PerfCounters::values();
+    QCOMPARE(values.value("cacheEvictions").toLongLong(), qint64(3));
+    QCOMPARE(values.value("cacheBytes").toLongLong(), qint64(600));
+    QCOMPARE(values.value("cacheBytes.peak").toLongLong(), qint64(1000));
+    QCOMPARE(values.value("renderQueueDepth").toLongLong(), qint64(1));
+    QCOMPARE(values.value("renderQueueDepth.peak").toLongLong(), qint64(3));
+    QVERIFY(!values.contains("cacheEvictions.peak"));
+}
+
+void Ut_PerfCounters::testHistogram()
+{
+    PerfCounters::addSample(PerfCounters::RenderTime, 100);
+    PerfCounters::addSample(PerfCounters::RenderTime, 1500);
+    PerfCounters::addSample(PerfCounters::RenderTime, 5000000);
+
+    const QVariantMap values = PerfCounters::values();
+    const QVariantList buckets = values.value("renderTime.buckets").toList();
+    QCOMPARE(buckets.size(), values.value("bucketLimitsUs").toList().size() + 1);
+    QCOMPARE(buckets.at(0).toLongLong(), qint64(1));
+    QCOMPARE(buckets.at(2).toLongLong(), qint64(1));
+    QCOMPARE(buckets.last().toLongLong(), qint64(1));
+    QCOMPARE(values.value("renderTime.count").toLongLong(), qint64(3));
+    QCOMPARE(values.value("renderTime.totalUs").toLongLong(), qint64(5001600));
+    QCOMPARE(values.value("renderTime.maxUs").toLongLong(), qint64(5000000));
+    QCOMPARE(values.value("pdfPaintTime.count").toLongLong(), qint64(0));
+}
+
+void Ut_PerfCounters::testHitRatio()
+{
+    QCOMPARE(PerfCounters::values().value("cacheHitRatio").toDouble(), 0.0);
+
+    PerfCounters::add(PerfCounters::CacheHits, 3);
+    PerfCounters::add(PerfCounters::CacheMisses);
+    PerfCounters::add(PerfCounters::SearchedPages, 4);
+    PerfCounters::addSample(PerfCounters::SearchTime, 2000000);
+
+    const QVariantMap values = PerfCounters::values();
+    QCOMPARE(values.value("cacheHitRatio").toDouble(), 0.75);
+    QCOMPARE(values.value("searchPagesPerSecond").toDouble(), 2.0);
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    Ut_PerfCounters test;
+    return QTest::qExec(&test, argc, argv);
+}
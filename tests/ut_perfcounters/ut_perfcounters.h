@@ -0,0 +1,19 @@
+#ifndef UT_PERFCOUNTERS_H
+#define UT_PERFCOUNTERS_H
+
+#include <QtTest/QtTest>
+#include <QObject>
+
+class Ut_PerfCounters : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void testCounters();
+    void testHistogram();
+    void testHitRatio();
+};
+
+#endif // UT_PERFCOUNTERS_H
@@ -0,0 +1,4 @@
+include(../common_head.pri)
+
+SOURCES += ut_perfcounters.cpp
+HEADERS += ut_perfcounters.h
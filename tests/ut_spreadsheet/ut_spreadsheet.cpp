@@ -2,6 +2,11 @@
 #define private public
 #include <officeviewerspreadsheet.h>
 #undef private
+#include <spreadsheetcommon.h>
+#include <Map.h>
+#include <Sheet.h>
+#include <Cell.h>
+#include <tables/Value.h>
 #include <actionpool.h>
 #include <definitions.h>
 #include <mapplication.h>
@@ -79,6 +84,47 @@ void Ut_SpreadSheet::testSearchText()
     QCOMPARE(spreadsheet->searchResults.at(0).count, 2);
 }
 
+void Ut_SpreadSheet::testSearchSheet()
+{
+    SheetSnapshot snapshot;
+    snapshot.sheetIndex = 0;
+    snapshot.positions << QPoint(2, 3) << QPoint(1, 1) << QPoint(5, 1) << QPoint(2, 3) << QPoint(4, 2);
+    snapshot.texts << "Total sum" << "SUMMARY" << "no match" << "sum in a comment" << "Sums";
+
+    // case insensitive, sorted by row and then column, a cell matching
+    // twice is reported once
+    QList<SheetResult> results = SpreadsheetSearch::searchSheet(snapshot, "sum");
+    QCOMPARE(results.count(), 3);
+    QCOMPARE(results.at(0).row, 1);
+    QCOMPARE(results.at(0).column, 1);
+    QCOMPARE(results.at(1).row, 2);
+    QCOMPARE(results.at(1).column, 4);
+    QCOMPARE(results.at(2).row, 3);
+    QCOMPARE(results.at(2).column, 2);
+
+    QVERIFY(SpreadsheetSearch::searchSheet(snapshot, "nothing").isEmpty());
+
+    SheetSnapshot empty;
+    empty.sheetIndex = 1;
+    QVERIFY(SpreadsheetSearch::searchSheet(empty, "sum").isEmpty());
+
+    // numbers are searched as they are shown
+    Calligra::Tables::Map map;
+    Calligra::Tables::Sheet *sheet = map.addNewSheet();
+    Calligra::Tables::Cell(sheet, 3, 4).setValue(Calligra::Tables::Value(2011));
+    Calligra::Tables::Cell(sheet, 1, 2).setValue(Calligra::Tables::Value(7));
+    Calligra::Tables::Cell(sheet, 2, 1).setUserInput("Year 2011");
+
+    SheetSnapshot values = SpreadsheetSearch::snapshotSheet(sheet, 0);
+    QVERIFY(values.texts.contains("2011"));
+    results = SpreadsheetSearch::searchSheet(values, "201");
+    QCOMPARE(results.count(), 2);
+    QCOMPARE(results.at(0).row, 1);
+    QCOMPARE(results.at(0).column, 2);
+    QCOMPARE(results.at(1).row, 4);
+    QCOMPARE(results.at(1).column, 3);
+}
+
 
 
 int main(int argc, char* argv[])
@@ -23,6 +23,7 @@ private Q_SLOTS:
     void testFloatingIndicators();
     void testNoIndicators();
     void testSearchText();
+    void testSearchSheet();
 
 private:
     OfficeViewerSpreadsheet *spreadsheet;